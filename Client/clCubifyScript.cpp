@@ -137,38 +137,100 @@ namespace Client::Scripts
 			return {};
 		}
 
-		WeakObjectBase nearest_cube;
-		float          nearest_distance = std::numeric_limits<float>::max();
+		StrongScene      scene;
+		StrongObjectBase player;
 
-		for (const auto& id : m_cube_ids_)
+		if (!LockWeak(owner->GetScene(), scene))
 		{
-			if (const auto& cube = owner->GetChild(id).lock())
-			{
-				const auto& tr = cube->GetComponent<Components::Transform>().lock();
+			return {};
+		}
+		if (!LockWeak(scene->GetMainActor(), player))
+		{
+			return {};
+		}
 
-				if (!tr)
-				{
-					continue;
-				}
-				// If cube is not active, then cube is not in the view.
-				if (!cube->GetActive())
-				{
-					continue;
-				}
+		const auto& player_script = player->GetScript<FezPlayerScript>().lock();
+		const auto& tr            = owner->GetComponent<Components::Transform>().lock();
 
-				// Blocking player teleporting to upper side.
-				if (tr->GetWorldPosition().y > pos.y)
-				{
-					continue;
-				}
+		if (!player_script || !tr)
+		{
+			return {};
+		}
 
-				const auto& distance = Vector3::DistanceSquared(tr->GetWorldPosition(), pos);
+		const auto& grid       = scene->GetHashGrid();
+		const auto& cell_size  = grid.GetCellSize();
+		const auto& axis       = s_depth_axes[player_script->GetRotationOffset()];
+		const auto& lateral    = Vector3::Up.Cross(axis);
+		const auto& obj_pos    = tr->GetWorldPosition();
+		const auto& half_scale = tr->GetWorldScale() * 0.5f;
+
+		// Cells from the position to the bottom of the cubes, and from the position to the far side of the cubes
+		// along the view axis.
+		const float min_cell = std::min({cell_size.x, cell_size.y, cell_size.z});
+		const int   rows     = static_cast<int>(std::ceil((pos.y - (obj_pos.y - half_scale.y)) / cell_size.y));
+		const int   range    = static_cast<int>
+				(
+				 std::ceil
+				 (
+				  (std::fabsf((obj_pos - pos).Dot(axis)) + std::max({half_scale.x, half_scale.y, half_scale.z})) /
+				  min_cell
+				 )
+				);
+
+		// Cubes are registered by the center, the cube larger than the cell can cover the position from the
+		// lateral cells as far as its half extent.
+		const Vector3 cube_extent = m_cube_dimension_ * tr->GetWorldScale();
+		const int     sides = std::max(1, static_cast<int>(std::ceil(std::fabsf(lateral.Dot(cube_extent)) * 0.5f / min_cell)));
 
-				if (distance < nearest_distance)
-				{
-					nearest_distance = distance;
-					nearest_cube     = cube;
-				}
+		WeakObjectBase nearest_cube;
+		float          nearest_distance = std::numeric_limits<float>::max();
+
+		// Rows from the position to the bottom, the nearest cube of every row is a candidate.
+		for (int row = 0; row <= rows; ++row)
+		{
+			// Cubes of this row and below are at least a row lower than the nearest one.
+			if (const float gap = cell_size.y * static_cast<float>(row - 1);
+				row > 0 && gap * gap > nearest_distance)
+			{
+				break;
+			}
+
+			for (int side = -sides; side <= sides; ++side)
+			{
+				const Vector3 origin = pos - Vector3{0.f, cell_size.y * row, 0.f} +
+				                       lateral * (min_cell * static_cast<float>(side));
+
+				grid.DepthRay
+						(
+						 origin, axis, range, [&](const WeakObjectBase& obj)
+						 {
+							 const auto& cube = obj.lock();
+
+							 // If cube is not active, then cube is not in the view.
+							 if (!cube || !cube->GetActive() || cube->GetParent().lock() != owner)
+							 {
+								 return false;
+							 }
+
+							 const auto& cube_pos = cube->GetComponent<Components::Transform>().lock()->GetWorldPosition();
+
+							 // Blocking player teleporting to upper side.
+							 if (cube_pos.y > pos.y)
+							 {
+								 return false;
+							 }
+
+							 if (const float distance = Vector3::DistanceSquared(cube_pos, pos);
+								 distance < nearest_distance)
+							 {
+								 nearest_distance = distance;
+								 nearest_cube     = cube;
+							 }
+
+							 // Cells are walked from the nearest depth, the rest of the ray is farther.
+							 return true;
+						 }
+						);
 			}
 		}
 
@@ -271,16 +333,6 @@ namespace Client::Scripts
 			s_move_offsets[3] * z_step
 		};
 
-		// Fix values of axis with player's value, to correct the cube with player's movement.
-		// This values are same as the camera's forward.
-		static const Vector3 fixed_axis[4] =
-		{
-			g_forward,
-			Vector3::Left,
-			g_backward,
-			Vector3::Right
-		};
-
 		if (const auto& owner = GetOwner().lock())
 		{
 			StrongObjectBase player;
@@ -354,10 +406,11 @@ namespace Client::Scripts
 
 			Vector3 start_pos = start_pos_by_rotation[rotation_offset];
 
+			// Fix values of axis with player's value, to correct the cube with player's movement.
 			if (!normal && m_cube_type_ != CUBE_TYPE_NORMAL)
 			{
 				const auto& delta       = player_pos - obj_pos;
-				const auto& axis_offset = fixed_axis[rotation_offset] * delta.Dot(fixed_axis[rotation_offset]);
+				const auto& axis_offset = s_depth_axes[rotation_offset] * delta.Dot(s_depth_axes[rotation_offset]);
 				start_pos               = start_pos + axis_offset;
 			}
 
@@ -372,8 +425,8 @@ namespace Client::Scripts
 				if (!normal && m_cube_type_ != CUBE_TYPE_NORMAL)
 				{
 					const auto& delta       = player_pos - obj_pos;
-					const auto& proj        = delta.Dot(fixed_axis[rotation_offset]);
-					const auto& axis_offset = fixed_axis[rotation_offset] * proj;
+					const auto& proj        = delta.Dot(s_depth_axes[rotation_offset]);
+					const auto& axis_offset = s_depth_axes[rotation_offset] * proj;
 					start_pos               = start_pos + axis_offset;
 				}
 
@@ -398,6 +451,7 @@ namespace Client::Scripts
 					cube_tr->SetLocalPosition(start_pos);
 
 					m_cube_ids_.push_back(cube->GetLocalID());
+					scene->GetHashGrid().Register(cube, cube_tr->GetWorldPosition());
 
 					start_pos += move_offset_by_rotation[rotation_offset];
 				}
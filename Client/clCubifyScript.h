@@ -16,6 +16,15 @@ namespace Client::Scripts
 			{0.f, 0.f, -1.f} // Generate cubes in -z axis
 		};
 
+		// View axis by the rotation offset of the player, same as the camera's forward.
+		inline constexpr static Vector3 s_depth_axes[4] =
+		{
+			{0.f, 0.f, -1.f}, // Forward
+			{-1.f, 0.f, 0.f}, // Left
+			{0.f, 0.f, 1.f},  // Backward
+			{1.f, 0.f, 0.f}   // Right
+		};
+
 		CLIENT_SCRIPT_T(CubifyScript, SCRIPT_T_CUBIFY)
 
 		explicit CubifyScript(const WeakObjectBase& owner);
@@ -220,12 +220,12 @@ namespace Client::Scripts
 		  m_state_(CHAR_STATE_IDLE),
 		  m_prev_state_(CHAR_STATE_IDLE),
 		  m_rotation_count_(0),
-		  m_accumulated_dt_(0),
 		  m_rotate_allowed_(true),
 		  m_rotate_finished_(false),
 		  m_rotate_consecutive_(false),
 		  m_b_climbing_(false),
-		  m_b_vaulting_(false) { }
+		  m_b_vaulting_(false),
+		  m_ground_sensor_(SpatialIndex::invalid_sensor) { }
 
 	void FezPlayerScript::IgnoreCollision() const
 	{
@@ -407,21 +407,9 @@ namespace Client::Scripts
 			return;
 		}
 
-		// Case where the player is rotating.
+		// Case where the player is rotating, the rotate routine sets the post rotate.
 		if (m_state_ == CHAR_STATE_ROTATE)
 		{
-			// Wait for the rotation to be close to the target rotation.
-			// todo: lerp rotation speed between 0 to 1
-			if (s_rotation_speed > m_accumulated_dt_)
-			{
-				const auto rot = tr->GetLocalRotation();
-				tr->SetLocalRotation(Quaternion::Slerp(rot, s_cw_rotations[m_rotation_count_], m_accumulated_dt_));
-				m_accumulated_dt_ += dt;
-				return;
-			}
-			// If the player is rotating and rotation is completed,
-			// Set the player's state to post rotate
-			m_state_ = CHAR_STATE_POST_ROTATE;
 			return;
 		}
 		if (m_prev_state_ == CHAR_STATE_POST_ROTATE &&
@@ -430,7 +418,6 @@ namespace Client::Scripts
 		{
 			// Set the rotation to the accurate target rotation.
 			tr->SetLocalRotation(s_cw_rotations[m_rotation_count_]);
-			m_accumulated_dt_ = 0.f;
 
 			// Player rotation is finished.
 			m_rotate_finished_ = true;
@@ -478,6 +465,9 @@ namespace Client::Scripts
 			}
 			m_state_ = CHAR_STATE_ROTATE;
 
+			StopCoroutines();
+			StartCoroutine(RotateRoutine());
+
 			if (!m_rotate_consecutive_)
 			{
 				m_last_spin_position_ = tr->GetWorldPosition();
@@ -683,6 +673,53 @@ namespace Client::Scripts
 		}
 	}
 
+	Coroutine FezPlayerScript::RotateRoutine()
+	{
+		float start = -1.f;
+
+		while (true)
+		{
+			{
+				// Strong references are released before suspending, the routine is owned by the scene and
+				// should not keep the scene or the owner alive.
+				const auto& owner = GetOwner().lock();
+				if (!owner || m_state_ != CHAR_STATE_ROTATE)
+				{
+					co_return;
+				}
+
+				const auto& scene = owner->GetScene().lock();
+				const auto& tr    = owner->GetComponent<Components::Transform>().lock();
+				if (!scene || !tr)
+				{
+					co_return;
+				}
+
+				const float now = scene->GetCoroutineScheduler().GetTime();
+
+				if (start < 0.f)
+				{
+					start = now;
+				}
+
+				const float elapsed = now - start;
+
+				if (elapsed >= s_rotation_speed)
+				{
+					break;
+				}
+
+				// todo: lerp rotation speed between 0 to 1
+				const auto rot = tr->GetLocalRotation();
+				tr->SetLocalRotation(Quaternion::Slerp(rot, s_cw_rotations[m_rotation_count_], elapsed));
+			}
+
+			co_await NextFrame();
+		}
+
+		m_state_ = CHAR_STATE_POST_ROTATE;
+	}
+
 	void FezPlayerScript::UpdateGrounded()
 	{
 		if (GetOwner().expired())
@@ -708,61 +745,77 @@ namespace Client::Scripts
 		const auto& up     = tr->Up();
 		const auto& center = tr->GetWorldPosition();
 		const auto& down   = -up;
-		const auto& pos    = tr->GetLocalPosition();
 		bool        hit    = false;
 
-		const auto& octree = scene->GetObjectTree();
-		octree.Iterate
-				(
-				 pos, [&hit, &owner, &cldr, &center](const WeakObjectBase& obj)
-				 {
-					 if (const auto& locked = obj.lock())
-					 {
-						 if (locked == owner)
-						 {
-							 return false;
-						 }
-						 if (!GetCollisionDetector().IsCollisionLayer(owner->GetLayer(), locked->GetLayer()))
-						 {
-							 return false;
-						 }
-
-						 const auto& rcl = locked->GetComponent<Components::Collider>().lock();
-						 const auto& rtr = locked->GetComponent<Components::Transform>().lock();
-
-						 if (!rcl || !rtr)
-						 {
-							 return false;
-						 }
-						 if (!rcl->GetActive() || !rtr->GetActive())
-						 {
-							 return false;
-						 }
-
-						 const auto& rowner = rcl->GetOwner().lock();
-						 if (!rowner)
-						 {
-							 return false;
-						 }
-						 if (const auto& parent = owner->GetParent().lock();
-							 rowner == parent)
-						 {
-							 return false;
-						 }
-
-						 // Check whether two objects are colliding in direction of down
-						 // Also check for position in y-axis so that it doesn't collide with ceiling
-						 if (Components::Collider::Intersects(cldr, rcl, Vector3::Down) &&
-						     center.y > rtr->GetWorldPosition().y)
-						 {
-							 hit = true;
-							 return true;
-						 }
-					 }
-
-					 return false;
-				 }
-				);
+		// Sensor follows the player, the objects around are kept by the object tree instead of querying
+		// every frame.
+		const auto* sensor = scene->GetProximitySensor(m_ground_sensor_);
+
+		if (!sensor || sensor->attached != owner->GetID())
+		{
+			m_ground_sensor_ = scene->AddProximitySensor
+					(
+					 BoundingSphere(center, tr->GetWorldScale().Length()), owner
+					);
+			sensor = scene->GetProximitySensor(m_ground_sensor_);
+		}
+
+		const auto check = [&hit, &owner, &cldr, &center](const WeakObjectBase& obj)
+		{
+			if (const auto& locked = obj.lock())
+			{
+				if (locked == owner)
+				{
+					return false;
+				}
+				if (!GetCollisionDetector().IsCollisionLayer(owner->GetLayer(), locked->GetLayer()))
+				{
+					return false;
+				}
+
+				const auto& rcl = locked->GetComponent<Components::Collider>().lock();
+				const auto& rtr = locked->GetComponent<Components::Transform>().lock();
+
+				if (!rcl || !rtr)
+				{
+					return false;
+				}
+				if (!rcl->GetActive() || !rtr->GetActive())
+				{
+					return false;
+				}
+
+				const auto& rowner = rcl->GetOwner().lock();
+				if (!rowner)
+				{
+					return false;
+				}
+				if (const auto& parent = owner->GetParent().lock();
+					rowner == parent)
+				{
+					return false;
+				}
+
+				// Check whether two objects are colliding in direction of down
+				// Also check for position in y-axis so that it doesn't collide with ceiling
+				if (Components::Collider::Intersects(cldr, rcl, Vector3::Down) &&
+				     center.y > rtr->GetWorldPosition().y)
+				{
+					hit = true;
+					return true;
+				}
+			}
+
+			return false;
+		};
+
+		for (const auto& obj : sensor->members | std::views::values)
+		{
+			if (check(obj))
+			{
+				break;
+			}
+		}
 
 		if (hit)
 		{
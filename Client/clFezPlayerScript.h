@@ -30,12 +30,12 @@ namespace Client::Scripts
 			  m_state_(CHAR_STATE_IDLE),
 			  m_prev_state_(CHAR_STATE_IDLE),
 			  m_rotation_count_(0),
-			  m_accumulated_dt_(0),
 			  m_rotate_allowed_(true),
 			  m_rotate_finished_(false),
 			  m_rotate_consecutive_(false),
 			  m_b_climbing_(false),
-			  m_b_vaulting_(false) { }
+			  m_b_vaulting_(false),
+			  m_ground_sensor_(SpatialIndex::invalid_sensor) { }
 
 		void Initialize() override;
 		void PreUpdate(const float& dt) override;
@@ -100,6 +100,8 @@ namespace Client::Scripts
 		// State changes
 		void UpdateMove();
 		void UpdateRotate(float dt);
+		// Rotation animation, hands over to the post rotate state when finished.
+		Coroutine RotateRoutine();
 		void UpdateGrounded();
 
 		void UpdateInitialJump();
@@ -133,8 +135,6 @@ namespace Client::Scripts
 		// Rotation variables
 		// Count of 90 degree rotations
 		UINT m_rotation_count_;
-		// Animation time for rotation
-		float m_accumulated_dt_;
 
 		// Last position of player when rotating
 		Vector3 m_last_spin_position_;
@@ -149,6 +149,9 @@ namespace Client::Scripts
 		// Climb variables
 		bool m_b_climbing_;
 		bool m_b_vaulting_;
+
+		// Non-serialized, objects around the player for the grounded check.
+		SpatialIndex::SensorID m_ground_sensor_;
 	};
 } // namespace Client::Scripts
 
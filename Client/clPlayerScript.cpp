@@ -233,76 +233,48 @@ namespace Client::Scripts
 		const auto start   = head_tr->GetWorldPosition();
 		const auto forward = head_tr->Forward();
 
-		const auto end = start + forward * range;
-
 		if (const auto scene = GetOwner().lock()->GetScene().lock())
 		{
 			const auto& tree = scene->GetObjectTree();
 
-			std::queue<const Octree*> queue;
-			queue.push(&tree);
-
-			while (!queue.empty())
+			for (const auto& p_rhs : tree.Hitscan(start, forward, 0, range))
 			{
-				const auto  node     = queue.front();
-				const auto& value    = node->Read();
-				const auto& children = node->Next();
-				const auto& active   = node->ActiveChildren();
-				queue.pop();
-
-				for (const auto& p_rhs : value)
+				if (const auto& rhs = p_rhs.lock())
 				{
-					if (const auto& rhs = p_rhs.lock())
+					if (rhs->GetParent().lock() == owner)
 					{
-						if (rhs->GetParent().lock() == owner)
-						{
-							continue;
-						}
-						if (rhs == owner)
-						{
-							continue;
-						}
+						continue;
+					}
+					if (rhs == owner)
+					{
+						continue;
+					}
 
-						if (const auto& rcl = rhs->GetComponent<Components::Collider>().lock())
+					if (const auto& rcl = rhs->GetComponent<Components::Collider>().lock())
+					{
+						if (rcl->GetActive())
 						{
-							if (rcl->GetActive())
+							if (const auto script = rhs->GetScript<HitboxScript>().lock())
 							{
-								float dist = 0.f;
-
-								if (rcl->Intersects(start, forward, range, dist))
-								{
-									if (const auto script = rhs->GetScript<HitboxScript>().lock())
-									{
-										GetDebugger().Log
-												(
-												 std::format
-												 (
-												  "Hit {} for {} damage",
-												  rhs->GetName(),
-												  damage
-												 )
-												);
-
-										script->Hit(damage);
-									}
-									else
-									{
-										rcl->onCollisionEnter.Broadcast(lcl);
-									}
-								}
+								GetDebugger().Log
+										(
+										 std::format
+										 (
+										  "Hit {} for {} damage",
+										  rhs->GetName(),
+										  damage
+										 )
+										);
+
+								script->Hit(damage);
+							}
+							else
+							{
+								rcl->onCollisionEnter.Broadcast(lcl);
 							}
 						}
 					}
 				}
-
-				// Add children to stack.
-				for (int i = 7; i >= 0; --i)
-				{
-					if (children[i] && children[i]->Contains(end))
-					{
-						queue.push(children[i]);
-					}
-				}
 			}
 		}
 	}
@@ -493,60 +465,44 @@ namespace Client::Scripts
 
 	void PlayerScript::CheckGround() const
 	{
-		const auto  scene = GetOwner().lock()->GetScene().lock();
-		const auto& tree  = scene->GetObjectTree();
-		const auto  rb    = GetOwner().lock()->GetComponent<Components::Rigidbody>().lock();
-
-		std::queue<const Octree*> q;
-		q.push(&tree);
-
-		while (!q.empty())
-		{
-			const auto node = q.front();
-			q.pop();
-
-			const auto& value    = node->Read();
-			const auto& children = node->Next();
-
-			for (const auto v : value)
-			{
-				const auto lcl = GetOwner().lock()->GetComponent<Components::Collider>().lock();
-				const auto rcl = v.lock()->GetComponent<Components::Collider>().lock();
-
-				if (!GetCollisionDetector().IsCollisionLayer(GetOwner().lock()->GetLayer(), v.lock()->GetLayer()))
-				{
-					continue;
-				}
-				if (!rcl || lcl == rcl)
-				{
-					continue;
-				}
-
-				const auto owner        = rcl->GetOwner().lock();
-				const auto owner_parent = owner->GetParent();
-
-				if (owner_parent.lock() == GetOwner().lock())
-				{
-					continue;
-				}
-
-				if (Components::Collider::Intersects(lcl, rcl, Vector3::Down))
-				{
-					rb->SetGrounded(true);
-					return;
-				}
-			}
-
-			for (const auto& child : children)
-			{
-				if (child && child->Contains
-				    (
-				     GetOwner().lock()->GetComponent<Components::Transform>().lock()->GetWorldPosition()
-				    ))
-				{
-					q.push(child);
-				}
-			}
-		}
+		const auto  owner    = GetOwner().lock();
+		const auto  scene    = owner->GetScene().lock();
+		const auto& tree     = scene->GetObjectTree();
+		const auto  rb       = owner->GetComponent<Components::Rigidbody>().lock();
+		const auto  lcl      = owner->GetComponent<Components::Collider>().lock();
+		const auto  position = owner->GetComponent<Components::Transform>().lock()->GetWorldPosition();
+
+		tree.Iterate
+				(
+				 position, [&](const WeakObjectBase& v)
+				 {
+					 const auto rcl = v.lock()->GetComponent<Components::Collider>().lock();
+
+					 if (!GetCollisionDetector().IsCollisionLayer(owner->GetLayer(), v.lock()->GetLayer()))
+					 {
+						 return false;
+					 }
+					 if (!rcl || lcl == rcl)
+					 {
+						 return false;
+					 }
+
+					 const auto rcl_owner    = rcl->GetOwner().lock();
+					 const auto owner_parent = rcl_owner->GetParent();
+
+					 if (owner_parent.lock() == owner)
+					 {
+						 return false;
+					 }
+
+					 if (Components::Collider::Intersects(lcl, rcl, Vector3::Down))
+					 {
+						 rb->SetGrounded(true);
+						 return true;
+					 }
+
+					 return false;
+				 }
+				);
 	}
 }
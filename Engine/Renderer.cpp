@@ -8,7 +8,6 @@
 #include "egMaterial.h"
 #include "egModelRenderer.h"
 #include "egParticleRenderer.h"
-#include "egProjectionFrustum.h"
 #include "egReflectionEvaluator.h"
 #include "egSceneManager.hpp"
 #include "egShape.h"
@@ -34,12 +33,20 @@ namespace Engine::Manager::Graphics
 
 	void Renderer::PreRender(const float& dt)
 	{
-		// Pre-processing, Mapping the materials to the model renderers.
+		// Extraction, copy the render state of the scene to the back snapshot.
 		const auto& scene = GetSceneManager().GetActiveScene().lock();
-		BuildRenderMap(scene, m_render_candidates_, m_instance_count_);
+		const size_t back = m_snapshot_index_ ^ 1;
+		BuildRenderMap
+				(
+				 scene, m_snapshots_[back].candidates, m_snapshots_[back].instance_count,
+				 m_snapshots_[back].visible
+				);
+
+		// Publish, render passes read from the snapshot from now on.
+		m_snapshot_index_ = back;
 
 		m_tmp_instance_buffers_.reset();
-		m_tmp_instance_buffers_.resize(m_instance_count_);
+		m_tmp_instance_buffers_.resize(GetSnapshot().instance_count);
 		m_b_ready_ = true;
 	}
 
@@ -55,15 +62,12 @@ namespace Engine::Manager::Graphics
 
 				for (auto i = 0; i < SHADER_DOMAIN_MAX; ++i)
 				{
-					// Check culling.
-					RenderPass
+					// Culled at the extraction, draws the visible candidates only.
+					renderPass
 							(
-							 dt, static_cast<eShaderDomain>(i), false, cmd,
+							 dt, static_cast<eShaderDomain>(i), false, GetSnapshot().visible[i], cmd,
 							 m_tmp_descriptor_heaps_,
-							 m_tmp_instance_buffers_, [](const WeakObjectBase& obj)
-							 {
-								 return GetProjectionFrustum().CheckRender(obj);
-							 }, [i](const Weak<CommandPair>& c, const DescriptorPtr& h)
+							 m_tmp_instance_buffers_, nullptr, [i](const Weak<CommandPair>& c, const DescriptorPtr& h)
 							 {
 								 GetD3Device().DefaultRenderTarget(c);
 								 GetRenderPipeline().DefaultViewport(c);
@@ -136,11 +140,47 @@ namespace Engine::Manager::Graphics
 		const Weak<CommandPair>&                                                   w_cmd,
 		concurrent_vector<StrongDescriptorPtr>&                                    descriptor_heap_container,
 		StructuredBufferMemoryPool<SBs::InstanceSB>&                               instance_buffer_memory_pool,
-		const std::function<bool(const StrongObjectBase&)>&                        predicate,
+		const CandidatePredication&                                                predicate,
 		const std::function<void(const Weak<CommandPair>&, const DescriptorPtr&)>& initial_setup,
 		const std::function<void(const Weak<CommandPair>&, const DescriptorPtr&)>& post_setup,
 		const std::vector<StructuredBufferBase*>&                                  additional_structured_buffers = {}
 	)
+	{
+		renderPass
+				(
+				 dt, domain, shader_bypass, GetSnapshot().candidates[domain], w_cmd, descriptor_heap_container,
+				 instance_buffer_memory_pool, predicate, initial_setup, post_setup, additional_structured_buffers
+				);
+	}
+
+	UINT64 Renderer::GetInstanceCount() const
+	{
+		if (!m_b_ready_)
+		{
+			throw std::runtime_error("Renderer is not ready for rendering!");
+		}
+
+		return GetSnapshot().instance_count;
+	}
+
+	const RenderSnapshot& Renderer::GetSnapshot() const
+	{
+		return m_snapshots_[m_snapshot_index_];
+	}
+
+	void Renderer::renderPass(
+		const float                                  dt,
+		const eShaderDomain                          domain,
+		const bool                                   shader_bypass,
+		const RenderMap&                             target_set,
+		const Weak<CommandPair>&                     w_cmd,
+		DescriptorContainer&                         descriptor_heap_container,
+		StructuredBufferMemoryPool<SBs::InstanceSB>& instance_buffer_memory_pool,
+		const CandidatePredication&                  predicate,
+		const CommandDescriptorLambda&               initial_setup,
+		const CommandDescriptorLambda&               post_setup,
+		const std::vector<StructuredBufferBase*>&    additional_structured_buffers
+	)
 	{
 		if (!Ready())
 		{
@@ -148,13 +188,12 @@ namespace Engine::Manager::Graphics
 			return;
 		}
 
-		if (m_render_candidates_[domain].empty())
+		if (target_set.empty())
 		{
 			return;
 		}
 
-		const auto&                                                     target_set = m_render_candidates_[domain];
-		concurrent_hash_map<WeakMaterial, aligned_vector<const SBs::InstanceSB*>> final_mapping;
+		frame_concurrent_hash_map<WeakMaterial, frame_vector<const SBs::InstanceSB*>> final_mapping;
 
 		for (const auto& mtr_m : target_set | std::views::values)
 		{
@@ -162,7 +201,7 @@ namespace Engine::Manager::Graphics
 					(
 					 mtr_m.begin(), mtr_m.end(), [&](const CandidateTuple& tuple)
 					 {
-						 if (!predicate || predicate(std::get<0>(tuple).lock()))
+						 if (!predicate || predicate(tuple))
 						 {
 							 decltype(final_mapping)::accessor acc;
 
@@ -226,16 +265,6 @@ namespace Engine::Manager::Graphics
 		}
 	}
 
-	UINT64 Renderer::GetInstanceCount() const
-	{
-		if (!m_b_ready_)
-		{
-			throw std::runtime_error("Renderer is not ready for rendering!");
-		}
-
-		return m_instance_count_;
-	}
-
 	void Renderer::renderPassImpl(
 		const float                         dt,
 		eShaderDomain                       domain,
@@ -244,7 +273,7 @@ namespace Engine::Manager::Graphics
 		const StrongMaterial&               material,
 		const Weak<CommandPair>&            w_cmd,
 		const DescriptorPtr&                heap,
-		const aligned_vector<const SBs::InstanceSB*>& structured_buffers
+		const frame_vector<const SBs::InstanceSB*>& structured_buffers
 	)
 	{
 		const auto& cmd = w_cmd.lock();
@@ -267,4 +296,19 @@ namespace Engine::Manager::Graphics
 
 		instance_buffer.TransitionCommon(cmd->GetList(), D3D12_RESOURCE_STATE_ALL_SHADER_RESOURCE);
 	}
+
+	ManagerAccess Renderer::GetAccess(const eManagerPhase phase) const
+	{
+		switch (phase)
+		{
+		case MANAGER_PHASE_PRE_UPDATE:
+			return {MANAGER_ACCESS_NONE, MANAGER_ACCESS_RENDER_LIST | MANAGER_ACCESS_COMMAND};
+		case MANAGER_PHASE_PRE_RENDER:
+			return {MANAGER_ACCESS_SCENE | MANAGER_ACCESS_TRANSFORM | MANAGER_ACCESS_RESOURCE | MANAGER_ACCESS_FRUSTUM, MANAGER_ACCESS_RENDER_LIST | MANAGER_ACCESS_COMMAND};
+		case MANAGER_PHASE_RENDER:
+			return g_manager_access_exclusive;
+		default:
+			return g_manager_access_none;
+		}
+	}
 }
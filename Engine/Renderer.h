@@ -1,5 +1,6 @@
 #pragma once
 #include "egCommonRenderer.h"
+#include "egFrameArena.hpp"
 #include "egGraphicMemoryPool.hpp"
 #include "egManager.hpp"
 #include "egMaterial.h"
@@ -13,7 +14,8 @@ namespace Engine::Manager::Graphics
 	public:
 		explicit Renderer(SINGLETON_LOCK_TOKEN)
 			: Singleton(),
-			  m_b_ready_(false) {}
+			  m_b_ready_(false),
+			  m_snapshot_index_(0) {}
 
 		void PreUpdate(const float& dt) override;
 		void Update(const float& dt) override;
@@ -23,6 +25,7 @@ namespace Engine::Manager::Graphics
 		void PostRender(const float& dt) override;
 		void PostUpdate(const float& dt) override;
 		void Initialize() override;
+		ManagerAccess GetAccess(eManagerPhase phase) const override;
 
 		void AppendAdditionalStructuredBuffer(StructuredBufferBase* sb_ptr);
 
@@ -34,19 +37,35 @@ namespace Engine::Manager::Graphics
 			const Weak<CommandPair>&                     w_cmd,
 			DescriptorContainer&                         descriptor_heap_container,
 			StructuredBufferMemoryPool<SBs::InstanceSB>& instance_buffer_memory_pool,
-			const ObjectPredication&                     predicate,
+			const CandidatePredication&                  predicate,
 			const CommandDescriptorLambda&               initial_setup,
 			const CommandDescriptorLambda&               post_setup, const std::vector<StructuredBufferBase*>&
 			additional_structured_buffers
 		);
 
 		UINT64 GetInstanceCount() const;
+		// Latest published render state.
+		const RenderSnapshot& GetSnapshot() const;
 
 	private:
 		friend struct SingletonDeleter;
 		friend class RayTracer;
 		~Renderer() override = default;
 
+		void renderPass(
+			float                                        dt,
+			eShaderDomain                                domain,
+			bool                                         shader_bypass,
+			const RenderMap&                             target_set,
+			const Weak<CommandPair>&                     w_cmd,
+			DescriptorContainer&                         descriptor_heap_container,
+			StructuredBufferMemoryPool<SBs::InstanceSB>& instance_buffer_memory_pool,
+			const CandidatePredication&                  predicate,
+			const CommandDescriptorLambda&               initial_setup,
+			const CommandDescriptorLambda&               post_setup,
+			const std::vector<StructuredBufferBase*>&    additional_structured_buffers
+		);
+
 		void renderPassImpl(
 			const float                         dt,
 			eShaderDomain                       domain,
@@ -54,7 +73,7 @@ namespace Engine::Manager::Graphics
 			StructuredBuffer<SBs::InstanceSB> & instance_buffer,
 			const StrongMaterial &              material,
 			const Weak<CommandPair> &           w_cmd,
-			const DescriptorPtr &               heap, const aligned_vector<const SBs::InstanceSB*> & structured_buffers
+			const DescriptorPtr &               heap, const frame_vector<const SBs::InstanceSB*> & structured_buffers
 		);
 
 		bool m_b_ready_;
@@ -63,10 +82,11 @@ namespace Engine::Manager::Graphics
 		StructuredBufferMemoryPool<SBs::InstanceSB> m_tmp_instance_buffers_;
 		concurrent_vector<StrongDescriptorPtr>      m_tmp_descriptor_heaps_;
 
-		std::atomic<UINT64> m_instance_count_;
 		std::atomic<UINT64> m_current_instance_;
 
-		RenderMap m_render_candidates_[SHADER_DOMAIN_MAX];
+		// Snapshot is built into the back one and published by flipping the index.
+		RenderSnapshot      m_snapshots_[2];
+		std::atomic<size_t> m_snapshot_index_;
 	};
 }
 
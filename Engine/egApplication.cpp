@@ -1,6 +1,7 @@
 #include "pch.h"
 #include "egApplication.h"
 
+#include "egFrameArena.hpp"
 #include "egGlobal.h"
 #include "egManagerHelper.hpp"
 #include "imgui_impl_dx12.h"
@@ -25,7 +26,8 @@ namespace Engine::Manager
 	Application::Application(SINGLETON_LOCK_TOKEN)
 		: Singleton(),
 		  m_previous_keyboard_state_(),
-		  m_previous_mouse_state_()
+		  m_previous_mouse_state_(),
+		  m_fixed_step_(g_fixed_update_interval, g_fixed_update_max_steps, g_fixed_update_max_debt)
 	{
 		if (s_instantiated_)
 		{
@@ -46,6 +48,11 @@ namespace Engine::Manager
 		return m_timer->GetFramesPerSecond();
 	}
 
+	const FixedStepController& Application::GetFixedStep() const
+	{
+		return m_fixed_step_;
+	}
+
 	Keyboard::State Application::GetCurrentKeyState() const
 	{
 		return m_keyboard->GetState();
@@ -86,6 +93,7 @@ namespace Engine::Manager
 
 	Application::~Application()
 	{
+		waitSubmission();
 		SIGTERM();
 	}
 
@@ -118,6 +126,8 @@ namespace Engine::Manager
 		GetDebugger().Initialize();
 		GetRenderer().Initialize();
 		GetRayTracer().Initialize();
+
+		buildManagerGraph();
 	}
 
 	void Application::Tick()
@@ -133,195 +143,309 @@ namespace Engine::Manager
 
 	void Application::PreUpdate(const float& dt)
 	{
-		GetToolkitAPI().PreUpdate(dt);
-		GetTaskScheduler().PreUpdate(dt);
-		GetMouseManager().PreUpdate(dt);
-		GetCollisionDetector().PreUpdate(dt);
-		GetReflectionEvaluator().PreUpdate(dt);
-		GetSceneManager().PreUpdate(dt);
-		GetShadowManager().PreUpdate(dt);
-		GetResourceManager().PreUpdate(dt);
-		GetGraviton().PreUpdate(dt);
-		GetConstraintSolver().PreUpdate(dt);
-		GetPhysicsManager().PreUpdate(dt);
-		GetLerpManager().PreUpdate(dt);
-		GetProjectionFrustum().PreUpdate(dt);
-
-		GetRenderer().PreUpdate(dt);
-		GetShadowManager().PreUpdate(dt);
-		GetDebugger().PreUpdate(dt);
-		GetD3Device().PreUpdate(dt);
-		GetRenderPipeline().PreUpdate(dt);
+		runPhase(MANAGER_PHASE_PRE_UPDATE, dt);
 	}
 
 	void Application::FixedUpdate(const float& dt)
 	{
-		GetTaskScheduler().FixedUpdate(dt);
-		// collider or world update
-		GetSceneManager().FixedUpdate(dt);
-
-		// physics updates.
-		// gravity
-		GetGraviton().FixedUpdate(dt);
-		// collision detection
-		GetCollisionDetector().FixedUpdate(dt);
-		// constraint solver
-		GetConstraintSolver().FixedUpdate(dt);
-		// apply forces
-		GetPhysicsManager().FixedUpdate(dt);
-		// lerp rigidbody movements
-		GetLerpManager().FixedUpdate(dt);
-
-		GetMouseManager().FixedUpdate(dt);
-		GetReflectionEvaluator().FixedUpdate(dt);
-		GetShadowManager().FixedUpdate(dt);
-		GetResourceManager().FixedUpdate(dt);
-
-		GetProjectionFrustum().FixedUpdate(dt);
-		GetRenderer().FixedUpdate(dt);
-		GetShadowManager().FixedUpdate(dt);
-		GetDebugger().FixedUpdate(dt);
-		GetD3Device().FixedUpdate(dt);
-		GetToolkitAPI().FixedUpdate(dt);
+		runPhase(MANAGER_PHASE_FIXED_UPDATE, dt);
 	}
 
 	void Application::Update(const float& dt)
 	{
-		GetTaskScheduler().Update(dt);
-		GetMouseManager().Update(dt);
-		GetCollisionDetector().Update(dt);
-		GetReflectionEvaluator().Update(dt);
-		GetSceneManager().Update(dt);
-		GetResourceManager().Update(dt);
-		GetGraviton().Update(dt);
-		GetConstraintSolver().Update(dt);
-		GetPhysicsManager().Update(dt);
-		GetLerpManager().Update(dt);
-		GetProjectionFrustum().Update(dt);
-
-		GetRenderer().Update(dt);
-		GetShadowManager().Update(dt); // update light information
-		GetDebugger().Update(dt); // update debug flag
-		GetD3Device().Update(dt);
-		GetToolkitAPI().Update(dt); //fmod update
+		runPhase(MANAGER_PHASE_UPDATE, dt);
 	}
 
 	void Application::PreRender(const float& dt)
 	{
-		GetTaskScheduler().PreRender(dt);
-		GetMouseManager().PreRender(dt);
-		GetCollisionDetector().PreRender(dt);
-		GetToolkitAPI().PreRender(dt);
-		GetReflectionEvaluator().PreRender(dt);
-		GetSceneManager().PreRender(dt);
-		GetResourceManager().PreRender(dt);
-		GetGraviton().PreRender(dt);
-		GetConstraintSolver().PreRender(dt);
-		GetPhysicsManager().PreRender(dt);
-		GetLerpManager().PreRender(dt);
-		GetProjectionFrustum().PreRender(dt);
-		GetDebugger().PreRender(dt);
-		GetD3Device().PreRender(dt);
-
-		if (g_raytracing)
+		runPhase(MANAGER_PHASE_PRE_RENDER, dt);
+	}
+
+	void Application::Render(const float& dt)
+	{
+		runPhase(MANAGER_PHASE_RENDER, dt);
+	}
+
+	void Application::PostRender(const float& dt)
+	{
+		runPhase(MANAGER_PHASE_POST_RENDER, dt);
+	}
+
+	void Application::submit(const float dt)
+	{
+		runPhase(MANAGER_PHASE_SUBMIT, dt);
+	}
+
+	void Application::PostUpdate(const float& dt)
+	{
+		runPhase(MANAGER_PHASE_POST_UPDATE, dt);
+	}
+
+	void Application::buildManagerGraph()
+	{
+		const auto raytracing = []()
 		{
-			GetRayTracer().PreRender(dt); // pre-process render information
-			GetRaytracingPipeline().PreRender(dt); // clean up rtv, dsv, etc.
-		}
-		else
+			return g_raytracing.load();
+		};
+
+		const auto rasterization = []()
 		{
-			GetRenderer().PreRender(dt); // pre-process render information
-			GetShadowManager().PreRender(dt); // shadow resource command, executing shadow pass, set shadow resources.
-			GetRenderPipeline().PreRender(dt); // clean up rtv, dsv, etc.
+			return !g_raytracing.load();
+		};
+
+		addManagerNode(MANAGER_PHASE_PRE_UPDATE, GetToolkitAPI(), &Graphics::ToolkitAPI::PreUpdate);
+		addManagerNode(MANAGER_PHASE_PRE_UPDATE, GetTaskScheduler(), &TaskScheduler::PreUpdate);
+		addManagerNode(MANAGER_PHASE_PRE_UPDATE, GetMouseManager(), &MouseManager::PreUpdate);
+		addManagerNode(MANAGER_PHASE_PRE_UPDATE, GetCollisionDetector(), &Physics::CollisionDetector::PreUpdate);
+		addManagerNode(MANAGER_PHASE_PRE_UPDATE, GetReflectionEvaluator(), &Graphics::ReflectionEvaluator::PreUpdate);
+		addManagerNode(MANAGER_PHASE_PRE_UPDATE, GetSceneManager(), &SceneManager::PreUpdate);
+		addManagerNode(MANAGER_PHASE_PRE_UPDATE, GetShadowManager(), &Graphics::ShadowManager::PreUpdate);
+		addManagerNode(MANAGER_PHASE_PRE_UPDATE, GetResourceManager(), &ResourceManager::PreUpdate);
+		addManagerNode(MANAGER_PHASE_PRE_UPDATE, GetGraviton(), &Physics::Graviton::PreUpdate);
+		addManagerNode(MANAGER_PHASE_PRE_UPDATE, GetConstraintSolver(), &Physics::ConstraintSolver::PreUpdate);
+		addManagerNode(MANAGER_PHASE_PRE_UPDATE, GetPhysicsManager(), &Physics::PhysicsManager::PreUpdate);
+		addManagerNode(MANAGER_PHASE_PRE_UPDATE, GetLerpManager(), &Physics::LerpManager::PreUpdate);
+		addManagerNode(MANAGER_PHASE_PRE_UPDATE, GetProjectionFrustum(), &ProjectionFrustum::PreUpdate);
+
+		addManagerNode(MANAGER_PHASE_PRE_UPDATE, GetRenderer(), &Graphics::Renderer::PreUpdate);
+		addManagerNode(MANAGER_PHASE_PRE_UPDATE, GetShadowManager(), &Graphics::ShadowManager::PreUpdate);
+		addManagerNode(MANAGER_PHASE_PRE_UPDATE, GetDebugger(), &Debugger::PreUpdate);
+		addManagerNode(MANAGER_PHASE_PRE_UPDATE, GetD3Device(), &Graphics::D3Device::PreUpdate);
+		addManagerNode(MANAGER_PHASE_PRE_UPDATE, GetRenderPipeline(), &Graphics::RenderPipeline::PreUpdate);
+
+		addManagerNode(MANAGER_PHASE_FIXED_UPDATE, GetTaskScheduler(), &TaskScheduler::FixedUpdate);
+		// collider or world update
+		addManagerNode(MANAGER_PHASE_FIXED_UPDATE, GetSceneManager(), &SceneManager::FixedUpdate);
+
+		// physics updates.
+		// gravity
+		addManagerNode(MANAGER_PHASE_FIXED_UPDATE, GetGraviton(), &Physics::Graviton::FixedUpdate);
+		// collision detection
+		addManagerNode(MANAGER_PHASE_FIXED_UPDATE, GetCollisionDetector(), &Physics::CollisionDetector::FixedUpdate);
+		// constraint solver
+		addManagerNode(MANAGER_PHASE_FIXED_UPDATE, GetConstraintSolver(), &Physics::ConstraintSolver::FixedUpdate);
+		// apply forces
+		addManagerNode(MANAGER_PHASE_FIXED_UPDATE, GetPhysicsManager(), &Physics::PhysicsManager::FixedUpdate);
+		// lerp rigidbody movements
+		addManagerNode(MANAGER_PHASE_FIXED_UPDATE, GetLerpManager(), &Physics::LerpManager::FixedUpdate);
+
+		addManagerNode(MANAGER_PHASE_FIXED_UPDATE, GetMouseManager(), &MouseManager::FixedUpdate);
+		addManagerNode(MANAGER_PHASE_FIXED_UPDATE, GetReflectionEvaluator(), &Graphics::ReflectionEvaluator::FixedUpdate);
+		addManagerNode(MANAGER_PHASE_FIXED_UPDATE, GetShadowManager(), &Graphics::ShadowManager::FixedUpdate);
+		addManagerNode(MANAGER_PHASE_FIXED_UPDATE, GetResourceManager(), &ResourceManager::FixedUpdate);
+
+		addManagerNode(MANAGER_PHASE_FIXED_UPDATE, GetProjectionFrustum(), &ProjectionFrustum::FixedUpdate);
+		addManagerNode(MANAGER_PHASE_FIXED_UPDATE, GetRenderer(), &Graphics::Renderer::FixedUpdate);
+		addManagerNode(MANAGER_PHASE_FIXED_UPDATE, GetShadowManager(), &Graphics::ShadowManager::FixedUpdate);
+		addManagerNode(MANAGER_PHASE_FIXED_UPDATE, GetDebugger(), &Debugger::FixedUpdate);
+		addManagerNode(MANAGER_PHASE_FIXED_UPDATE, GetD3Device(), &Graphics::D3Device::FixedUpdate);
+		addManagerNode(MANAGER_PHASE_FIXED_UPDATE, GetToolkitAPI(), &Graphics::ToolkitAPI::FixedUpdate);
+
+		addManagerNode(MANAGER_PHASE_UPDATE, GetTaskScheduler(), &TaskScheduler::Update);
+		addManagerNode(MANAGER_PHASE_UPDATE, GetMouseManager(), &MouseManager::Update);
+		addManagerNode(MANAGER_PHASE_UPDATE, GetCollisionDetector(), &Physics::CollisionDetector::Update);
+		addManagerNode(MANAGER_PHASE_UPDATE, GetReflectionEvaluator(), &Graphics::ReflectionEvaluator::Update);
+		addManagerNode(MANAGER_PHASE_UPDATE, GetSceneManager(), &SceneManager::Update);
+		addManagerNode(MANAGER_PHASE_UPDATE, GetResourceManager(), &ResourceManager::Update);
+		addManagerNode(MANAGER_PHASE_UPDATE, GetGraviton(), &Physics::Graviton::Update);
+		addManagerNode(MANAGER_PHASE_UPDATE, GetConstraintSolver(), &Physics::ConstraintSolver::Update);
+		addManagerNode(MANAGER_PHASE_UPDATE, GetPhysicsManager(), &Physics::PhysicsManager::Update);
+		addManagerNode(MANAGER_PHASE_UPDATE, GetLerpManager(), &Physics::LerpManager::Update);
+		addManagerNode(MANAGER_PHASE_UPDATE, GetProjectionFrustum(), &ProjectionFrustum::Update);
+
+		addManagerNode(MANAGER_PHASE_UPDATE, GetRenderer(), &Graphics::Renderer::Update);
+		addManagerNode(MANAGER_PHASE_UPDATE, GetShadowManager(), &Graphics::ShadowManager::Update); // update light information
+		addManagerNode(MANAGER_PHASE_UPDATE, GetDebugger(), &Debugger::Update); // update debug flag
+		addManagerNode(MANAGER_PHASE_UPDATE, GetD3Device(), &Graphics::D3Device::Update);
+		addManagerNode(MANAGER_PHASE_UPDATE, GetToolkitAPI(), &Graphics::ToolkitAPI::Update); //fmod update
+
+		addManagerNode(MANAGER_PHASE_PRE_RENDER, GetTaskScheduler(), &TaskScheduler::PreRender);
+		addManagerNode(MANAGER_PHASE_PRE_RENDER, GetMouseManager(), &MouseManager::PreRender);
+		addManagerNode(MANAGER_PHASE_PRE_RENDER, GetCollisionDetector(), &Physics::CollisionDetector::PreRender);
+		addManagerNode(MANAGER_PHASE_PRE_RENDER, GetToolkitAPI(), &Graphics::ToolkitAPI::PreRender);
+		addManagerNode(MANAGER_PHASE_PRE_RENDER, GetReflectionEvaluator(), &Graphics::ReflectionEvaluator::PreRender);
+		addManagerNode(MANAGER_PHASE_PRE_RENDER, GetSceneManager(), &SceneManager::PreRender);
+		addManagerNode(MANAGER_PHASE_PRE_RENDER, GetResourceManager(), &ResourceManager::PreRender);
+		addManagerNode(MANAGER_PHASE_PRE_RENDER, GetGraviton(), &Physics::Graviton::PreRender);
+		addManagerNode(MANAGER_PHASE_PRE_RENDER, GetConstraintSolver(), &Physics::ConstraintSolver::PreRender);
+		addManagerNode(MANAGER_PHASE_PRE_RENDER, GetPhysicsManager(), &Physics::PhysicsManager::PreRender);
+		addManagerNode(MANAGER_PHASE_PRE_RENDER, GetLerpManager(), &Physics::LerpManager::PreRender);
+		addManagerNode(MANAGER_PHASE_PRE_RENDER, GetProjectionFrustum(), &ProjectionFrustum::PreRender);
+		addManagerNode(MANAGER_PHASE_PRE_RENDER, GetDebugger(), &Debugger::PreRender);
+		addManagerNode(MANAGER_PHASE_PRE_RENDER, GetD3Device(), &Graphics::D3Device::PreRender);
+
+		addManagerNode(MANAGER_PHASE_PRE_RENDER, GetRayTracer(), &Graphics::RayTracer::PreRender, raytracing); // pre-process render information
+		addManagerNode(MANAGER_PHASE_PRE_RENDER, GetRaytracingPipeline(), &Graphics::RaytracingPipeline::PreRender, raytracing); // clean up rtv, dsv, etc.
+		addManagerNode(MANAGER_PHASE_PRE_RENDER, GetRenderer(), &Graphics::Renderer::PreRender, rasterization); // pre-process render information
+		addManagerNode(MANAGER_PHASE_PRE_RENDER, GetShadowManager(), &Graphics::ShadowManager::PreRender, rasterization); // shadow resource command, executing shadow pass, set shadow resources.
+		addManagerNode(MANAGER_PHASE_PRE_RENDER, GetRenderPipeline(), &Graphics::RenderPipeline::PreRender, rasterization); // clean up rtv, dsv, etc.
+
+		addManagerNode(MANAGER_PHASE_RENDER, GetTaskScheduler(), &TaskScheduler::Render);
+		addManagerNode(MANAGER_PHASE_RENDER, GetMouseManager(), &MouseManager::Render);
+		addManagerNode(MANAGER_PHASE_RENDER, GetCollisionDetector(), &Physics::CollisionDetector::Render);
+		addManagerNode(MANAGER_PHASE_RENDER, GetReflectionEvaluator(), &Graphics::ReflectionEvaluator::Render);
+		addManagerNode(MANAGER_PHASE_RENDER, GetSceneManager(), &SceneManager::Render);
+		addManagerNode(MANAGER_PHASE_RENDER, GetResourceManager(), &ResourceManager::Render);
+		addManagerNode(MANAGER_PHASE_RENDER, GetGraviton(), &Physics::Graviton::Render);
+		addManagerNode(MANAGER_PHASE_RENDER, GetConstraintSolver(), &Physics::ConstraintSolver::PreRender);
+		addManagerNode(MANAGER_PHASE_RENDER, GetPhysicsManager(), &Physics::PhysicsManager::Render);
+		addManagerNode(MANAGER_PHASE_RENDER, GetLerpManager(), &Physics::LerpManager::Render);
+		addManagerNode(MANAGER_PHASE_RENDER, GetProjectionFrustum(), &ProjectionFrustum::Render);
+
+		addManagerNode(MANAGER_PHASE_RENDER, GetRayTracer(), &Graphics::RayTracer::Render, raytracing);
+
+		addManagerNode(MANAGER_PHASE_RENDER, GetRaytracingPipeline(), &Graphics::RaytracingPipeline::Render, raytracing);
+		// Shadow resource binding
+		addManagerNode(MANAGER_PHASE_RENDER, GetShadowManager(), &Graphics::ShadowManager::Render, rasterization);
+
+		// Render commands (opaque)
+		addManagerNode(MANAGER_PHASE_RENDER, GetRenderer(), &Graphics::Renderer::Render, rasterization);
+		addManagerNode(MANAGER_PHASE_RENDER, GetRenderPipeline(), &Graphics::RenderPipeline::Render, rasterization);
+
+		addManagerNode(MANAGER_PHASE_RENDER, GetImGuiManager(), &Graphics::ImGuiManager::Render);
+		addManagerNode(MANAGER_PHASE_RENDER, GetDebugger(), &Debugger::Render);
+		addManagerNode(MANAGER_PHASE_RENDER, GetToolkitAPI(), &Graphics::ToolkitAPI::Render);
+		addManagerNode(MANAGER_PHASE_RENDER, GetD3Device(), &Graphics::D3Device::Render);
+
+		addManagerNode(MANAGER_PHASE_POST_RENDER, GetTaskScheduler(), &TaskScheduler::PostRender);
+		addManagerNode(MANAGER_PHASE_POST_RENDER, GetMouseManager(), &MouseManager::PostRender);
+		addManagerNode(MANAGER_PHASE_POST_RENDER, GetCollisionDetector(), &Physics::CollisionDetector::PostRender);
+		addManagerNode(MANAGER_PHASE_POST_RENDER, GetSceneManager(), &SceneManager::PostRender);
+		addManagerNode(MANAGER_PHASE_POST_RENDER, GetResourceManager(), &ResourceManager::PostRender);
+		addManagerNode(MANAGER_PHASE_POST_RENDER, GetGraviton(), &Physics::Graviton::PostRender);
+		addManagerNode(MANAGER_PHASE_POST_RENDER, GetConstraintSolver(), &Physics::ConstraintSolver::PostRender);
+		addManagerNode(MANAGER_PHASE_POST_RENDER, GetPhysicsManager(), &Physics::PhysicsManager::PostRender);
+		addManagerNode(MANAGER_PHASE_POST_RENDER, GetLerpManager(), &Physics::LerpManager::PostRender);
+		addManagerNode(MANAGER_PHASE_POST_RENDER, GetProjectionFrustum(), &ProjectionFrustum::PostRender);
+		addManagerNode(MANAGER_PHASE_SUBMIT, GetDebugger(), &Debugger::PostRender); // gather information until render
+
+		addManagerNode(MANAGER_PHASE_SUBMIT, GetRenderer(), &Graphics::Renderer::PostRender);
+		addManagerNode(MANAGER_PHASE_SUBMIT, GetToolkitAPI(), &Graphics::ToolkitAPI::PostRender); // toolkit related render commands
+		addManagerNode(MANAGER_PHASE_SUBMIT, GetShadowManager(), &Graphics::ShadowManager::PostRender);
+
+		addManagerNode(MANAGER_PHASE_SUBMIT, GetImGuiManager(), &Graphics::ImGuiManager::PostRender);
+
+		addManagerNode(MANAGER_PHASE_SUBMIT, GetReflectionEvaluator(), &Graphics::ReflectionEvaluator::PostRender);
+		addManagerNode(MANAGER_PHASE_SUBMIT, GetRenderPipeline(), &Graphics::RenderPipeline::PostRender); // Wrap up command lists, present
+		addManagerNode(MANAGER_PHASE_SUBMIT, GetD3Device(), &Graphics::D3Device::PostRender);
+
+		addManagerNode(MANAGER_PHASE_POST_UPDATE, GetTaskScheduler(), &TaskScheduler::PostUpdate);
+		addManagerNode(MANAGER_PHASE_POST_UPDATE, GetMouseManager(), &MouseManager::PostUpdate);
+		addManagerNode(MANAGER_PHASE_POST_UPDATE, GetCollisionDetector(), &Physics::CollisionDetector::PostUpdate);
+		addManagerNode(MANAGER_PHASE_POST_UPDATE, GetSceneManager(), &SceneManager::PostUpdate);
+		addManagerNode(MANAGER_PHASE_POST_UPDATE, GetResourceManager(), &ResourceManager::PostUpdate);
+		addManagerNode(MANAGER_PHASE_POST_UPDATE, GetGraviton(), &Physics::Graviton::PostUpdate);
+		addManagerNode(MANAGER_PHASE_POST_UPDATE, GetConstraintSolver(), &Physics::ConstraintSolver::PostUpdate);
+		addManagerNode(MANAGER_PHASE_POST_UPDATE, GetPhysicsManager(), &Physics::PhysicsManager::PostUpdate);
+		addManagerNode(MANAGER_PHASE_POST_UPDATE, GetLerpManager(), &Physics::LerpManager::PostUpdate);
+		addManagerNode(MANAGER_PHASE_POST_UPDATE, GetProjectionFrustum(), &ProjectionFrustum::PostUpdate);
+		addManagerNode(MANAGER_PHASE_POST_UPDATE, GetRenderer(), &Graphics::Renderer::PostUpdate);
+		addManagerNode(MANAGER_PHASE_POST_UPDATE, GetShadowManager(), &Graphics::ShadowManager::PostUpdate);
+		addManagerNode(MANAGER_PHASE_POST_UPDATE, GetDebugger(), &Debugger::PostUpdate);
+		addManagerNode(MANAGER_PHASE_POST_UPDATE, GetD3Device(), &Graphics::D3Device::PostUpdate);
+		addManagerNode(MANAGER_PHASE_POST_UPDATE, GetToolkitAPI(), &Graphics::ToolkitAPI::PostUpdate);
+		addManagerNode(MANAGER_PHASE_POST_UPDATE, GetReflectionEvaluator(), &Graphics::ReflectionEvaluator::PostUpdate);
+		addManagerNode(MANAGER_PHASE_POST_UPDATE, GetRenderPipeline(), &Graphics::RenderPipeline::PostUpdate);
+
+		for (int phase = 0; phase < MANAGER_PHASE_MAX; ++phase)
+		{
+			const auto& nodes        = m_manager_nodes_[phase];
+			auto&       dependencies = m_manager_dependencies_[phase];
+
+			dependencies.clear();
+			dependencies.resize(nodes.size());
+
+			// Every earlier node that conflicts with the node should be finished before starting.
+			for (size_t i = 0; i < nodes.size(); ++i)
+			{
+				for (size_t j = 0; j < i; ++j)
+				{
+					if (nodes[i].access.Conflicts(nodes[j].access))
+					{
+						dependencies[i].push_back(j);
+					}
+				}
+			}
 		}
 	}
 
-	void Application::Render(const float& dt)
+	void Application::runPhase(const eManagerPhase phase, const float dt)
 	{
-		GetTaskScheduler().Render(dt);
-		GetMouseManager().Render(dt);
-		GetCollisionDetector().Render(dt);
-		GetReflectionEvaluator().Render(dt);
-		GetSceneManager().Render(dt);
-		GetResourceManager().Render(dt);
-		GetGraviton().Render(dt);
-		GetConstraintSolver().PreRender(dt);
-		GetPhysicsManager().Render(dt);
-		GetLerpManager().Render(dt);
-		GetProjectionFrustum().Render(dt);
-
-		if (g_raytracing)
+		const auto& nodes        = m_manager_nodes_[phase];
+		const auto& dependencies = m_manager_dependencies_[phase];
+
+		// Deterministic fallback, runs in the declared order.
+		if (!g_parallel_managers)
 		{
-			GetRayTracer().Render(dt);
+			for (const auto& node : nodes)
+			{
+				if (!node.condition || node.condition())
+				{
+					node.func(dt);
+				}
+			}
 
-			GetRaytracingPipeline().Render(dt);
+			return;
 		}
-		else
+
+		std::vector<TaskScheduler::JobHandle> handles(nodes.size());
+
+		for (size_t i = 0; i < nodes.size(); ++i)
 		{
-			// Shadow resource binding
-			GetShadowManager().Render(dt);
+			const auto& node = nodes[i];
 
-			// Render commands (opaque)
-			GetRenderer().Render(dt);
-			GetRenderPipeline().Render(dt);
-		}
+			if (node.condition && !node.condition())
+			{
+				continue;
+			}
 
-		GetImGuiManager().Render(dt);
-		GetDebugger().Render(dt);
-		GetToolkitAPI().Render(dt);
-		GetD3Device().Render(dt);
-	}
+			// Exclusive node runs in the caller thread after every previous node is finished.
+			if (node.access.Exclusive())
+			{
+				for (auto& handle : handles)
+				{
+					GetTaskScheduler().Wait(handle);
+					handle.reset();
+				}
+
+				node.func(dt);
+				continue;
+			}
 
-	void Application::PostRender(const float& dt)
-	{
-		GetTaskScheduler().PostRender(dt);
-		GetMouseManager().PostRender(dt);
-		GetCollisionDetector().PostRender(dt);
-		GetSceneManager().PostRender(dt);
-		GetResourceManager().PostRender(dt);
-		GetGraviton().PostRender(dt);
-		GetConstraintSolver().PostRender(dt);
-		GetPhysicsManager().PostRender(dt);
-		GetLerpManager().PostRender(dt);
-		GetProjectionFrustum().PostRender(dt);
-		GetDebugger().PostRender(dt); // gather information until render
-
-		GetRenderer().PostRender(dt);
-		GetToolkitAPI().PostRender(dt); // toolkit related render commands
-		GetShadowManager().PostRender(dt);
-
-		GetImGuiManager().PostRender(dt);
-
-		GetReflectionEvaluator().PostRender(dt);
-		GetRenderPipeline().PostRender(dt); // Wrap up command lists, present
-		GetD3Device().PostRender(dt);
-	}
+			// Does not touch anything, not worth to spawn.
+			if (node.access.Empty())
+			{
+				node.func(dt);
+				continue;
+			}
 
-	void Application::PostUpdate(const float& dt)
-	{
-		GetTaskScheduler().PostUpdate(dt);
-		GetMouseManager().PostUpdate(dt);
-		GetCollisionDetector().PostUpdate(dt);
-		GetSceneManager().PostUpdate(dt);
-		GetResourceManager().PostUpdate(dt);
-		GetGraviton().PostUpdate(dt);
-		GetConstraintSolver().PostUpdate(dt);
-		GetPhysicsManager().PostUpdate(dt);
-		GetLerpManager().PostUpdate(dt);
-		GetProjectionFrustum().PostUpdate(dt);
-		GetRenderer().PostUpdate(dt);
-		GetShadowManager().PostUpdate(dt);
-		GetDebugger().PostUpdate(dt);
-		GetD3Device().PostUpdate(dt);
-		GetToolkitAPI().PostUpdate(dt);
-		GetReflectionEvaluator().PostUpdate(dt);
-		GetRenderPipeline().PostUpdate(dt);
+			std::vector<TaskScheduler::JobHandle> node_dependencies;
+
+			for (const size_t dependency : dependencies[i])
+			{
+				if (handles[dependency])
+				{
+					node_dependencies.push_back(handles[dependency]);
+				}
+			}
+
+			handles[i] = GetTaskScheduler().Spawn
+					(
+					 [&node, dt]()
+					 {
+						 node.func(dt);
+					 }, node_dependencies
+					);
+		}
+
+		for (const auto& handle : handles)
+		{
+			GetTaskScheduler().Wait(handle);
+		}
 	}
 
 	void Application::tickInternal()
 	{
-		static float elapsed = 0.f;
-
 		if (m_keyboard->GetState().Escape)
 		{
 			PostQuitMessage(0);
@@ -331,30 +455,62 @@ namespace Engine::Manager
 
 		if (g_paused)
 		{
-			elapsed = 0.f;
-			dt      = 0.f;
+			m_fixed_step_.Reset();
+			dt = 0.f;
 		}
 
-		GetImGuiManager().NewFrame();
+		const UINT steps = m_fixed_step_.Advance(dt);
 
-		while (elapsed >= g_fixed_update_interval)
+		// If the render is pipelined, fixed updates are overlapped with the submission of the previous frame.
+		// Render passes read from the render snapshot, and submission does not touch the simulation state.
+		for (UINT i = 0; i < steps; ++i)
 		{
-			FixedUpdate(g_fixed_update_interval);
-			elapsed -= g_fixed_update_interval;
+			FixedUpdate(m_fixed_step_.GetInterval());
 		}
-		
+
+		waitSubmission();
+
+		// Every transient container of the previous frame and the fixed updates is gone.
+		FrameArena::ResetAll();
+
+		GetImGuiManager().NewFrame();
+
 		PreUpdate(dt);
 		Update(dt);
 		PostUpdate(dt);
 
 		PreRender(dt);
 		Render(dt);
+
+		// Scenes and scripts are finished in the main thread, only the submission is deferred.
 		PostRender(dt);
 
+		if (g_pipelined_render)
+		{
+			m_submission_ = GetTaskScheduler().Spawn
+					(
+					 [this, dt]()
+					 {
+						 submit(dt);
+					 }
+					);
+		}
+		else
+		{
+			submit(dt);
+		}
+
 		m_previous_keyboard_state_ = m_keyboard->GetState();
 		m_previous_mouse_state_    = m_mouse->GetState();
+	}
 
-		elapsed += dt;
+	void Application::waitSubmission()
+	{
+		if (m_submission_)
+		{
+			GetTaskScheduler().Wait(m_submission_);
+			m_submission_.reset();
+		}
 	}
 
 	void Application::SIGTERM()
@@ -1,4 +1,6 @@
 #pragma once
+#include <array>
+#include <functional>
 #include <memory>
 
 #include <Keyboard.h>
@@ -6,7 +8,9 @@
 
 #include "StepTimer.hpp"
 #include "egDescriptors.h"
+#include "egFixedStepController.h"
 #include "egManager.hpp"
+#include "egTaskScheduler.h"
 
 #include "imgui.h"
 #include "imgui_impl_win32.h"
@@ -34,8 +38,9 @@ namespace Engine::Manager
 
 		LRESULT MessageHandler(HWND hwnd, UINT msg, WPARAM wparam, LPARAM lparam);
 
-		float           GetDeltaTime() const;
-		uint32_t        GetFPS() const;
+		float                      GetDeltaTime() const;
+		uint32_t                   GetFPS() const;
+		const FixedStepController& GetFixedStep() const;
 		Keyboard::State GetCurrentKeyState() const;
 
 		// More strict key change check. Returns true if previously not pressed
@@ -63,7 +68,37 @@ namespace Engine::Manager
 		void PostRender(const float& dt) override;
 		void PostUpdate(const float& dt) override;
 
+		// Manager phase function with the declared access of the phase.
+		struct ManagerNode
+		{
+			std::function<void(float)> func;
+			ManagerAccess              access;
+			// Node is skipped if the condition is given and not satisfied.
+			std::function<bool()> condition;
+		};
+
+		template <typename T, typename Fn>
+		void addManagerNode(const eManagerPhase phase, T& manager, Fn func, const std::function<bool()>& condition = {})
+		{
+			m_manager_nodes_[phase].push_back
+					(
+					 {
+						 [&manager, func](const float dt)
+						 {
+							 (manager.*func)(dt);
+						 },
+						 manager.GetAccess(phase), condition
+					 }
+					);
+		}
+
+		void buildManagerGraph();
+		// Runs the managers of the phase, non-conflicting managers are run in parallel.
+		void runPhase(eManagerPhase phase, float dt);
+
 		void tickInternal();
+		void submit(float dt);
+		void waitSubmission();
 
 		static void SIGTERM();
 
@@ -78,6 +113,15 @@ namespace Engine::Manager
 
 		// Time
 		std::unique_ptr<DX::StepTimer> m_timer;
+		FixedStepController            m_fixed_step_;
+
+		// Managers in the calling order of each phase.
+		std::array<std::vector<ManagerNode>, MANAGER_PHASE_MAX> m_manager_nodes_;
+		// Indices of the earlier conflicting nodes of each node.
+		std::array<std::vector<std::vector<size_t>>, MANAGER_PHASE_MAX> m_manager_dependencies_;
+
+		// Submission of the previous frame, in flight if the render is pipelined.
+		TaskScheduler::JobHandle m_submission_;
 
 		// Check for Sigterm registration
 		inline static bool s_instantiated_ = false;
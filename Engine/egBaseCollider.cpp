@@ -17,6 +17,7 @@
 #include <imgui_stdlib.h>
 
 #include "egCollision.h"
+#include "egConvexHull.hpp"
 #include "egCubeMesh.h"
 #include "egD3Device.hpp"
 #include "egGlobal.h"
@@ -64,6 +65,33 @@ namespace Engine::Components
 		throw std::logic_error("Unknown type of collider vertices");
 	}
 
+	const Physics::WorldVertexCollection& Collider::GetWorldVertices() const
+	{
+		const Matrix world = GetWorldMatrix();
+
+		// Vertices of the shape are changed after the hull is taken.
+		if (const auto model = m_shape_.lock(); model && model->GetRevision() != m_shape_revision_)
+		{
+			UpdateHull();
+		}
+
+		if (m_world_vertices_dirty_ || world != m_world_vertices_matrix_)
+		{
+			if (m_hull_)
+			{
+				m_world_vertices_.Transform(m_hull_, world);
+			}
+			else
+			{
+				m_world_vertices_.Transform(GetVertices(), world);
+			}
+			m_world_vertices_matrix_ = world;
+			m_world_vertices_dirty_  = false;
+		}
+
+		return m_world_vertices_;
+	}
+
 	Matrix Collider::GetWorldMatrix() const
 	{
 		return GetLocalMatrix() * GetOwner().lock()->GetComponent<Transform>().lock()->GetWorldMatrix();
@@ -85,6 +113,7 @@ namespace Engine::Components
 		}
 
 		InitializeStockVertices();
+		UpdateHull();
 
 #ifdef PHYSX_ENABLED
 		// todo: move friction value from rb to collider
@@ -177,6 +206,16 @@ namespace Engine::Components
 			}
 		}
 
+		if (!s_cube_stock_hull_)
+		{
+			s_cube_stock_hull_ = boost::make_shared<const Physics::ConvexHull>(Physics::ConvexHull::Build(s_cube_stock_));
+		}
+		if (!s_sphere_stock_hull_)
+		{
+			s_sphere_stock_hull_ = boost::make_shared<const Physics::ConvexHull>
+					(Physics::ConvexHull::Build(s_sphere_stock_));
+		}
+
 #ifdef PHYSX_ENABLED
 
 		if (!s_px_cube_stock_)
@@ -195,6 +234,8 @@ namespace Engine::Components
 	void Collider::FromMatrix(const Matrix& mat)
 	{
 		m_local_matrix_ = mat;
+
+		NotifyBoundsChange();
 	}
 
 	void Collider::SetType(const eBoundingType type)
@@ -212,6 +253,9 @@ namespace Engine::Components
 		}
 
 		UpdateInertiaTensor();
+		UpdateHull();
+
+		NotifyBoundsChange();
 	}
 
 	void Collider::SetMass(const float mass)
@@ -233,6 +277,8 @@ namespace Engine::Components
 		}
 
 		UpdateInertiaTensor();
+
+		NotifyBoundsChange();
 	}
 
 	void Collider::SetShape(const WeakModel& model)
@@ -241,6 +287,7 @@ namespace Engine::Components
 		{
 			m_shape_meta_path_ = locked->GetMetadataPath();
 			m_shape_           = locked;
+			UpdateHull();
 
 			BoundingOrientedBox obb;
 			BoundingOrientedBox::CreateFromBoundingBox(obb, locked->GetBoundingBox());
@@ -251,6 +298,7 @@ namespace Engine::Components
 			// Assuming model has been reset.
 			m_shape_meta_path_ = "";
 			m_shape_ = {};
+			UpdateHull();
 			SetBoundingBox({});
 		}
 
@@ -339,17 +387,66 @@ namespace Engine::Components
 		return m_collided_objects_;
 	}
 
+	namespace
+	{
+		using PenetrationTest = bool(*)(const Collider& lhs, const Collider& rhs, Physics::Penetration& out);
+
+		// Closed form tests of the primitives, indexed by the bounding type of lhs and rhs.
+		constexpr PenetrationTest s_penetration_tests[BOUNDING_TYPE_COUNT][BOUNDING_TYPE_COUNT] =
+		{
+			{
+				[](const Collider& lhs, const Collider& rhs, Physics::Penetration& out)
+				{
+					return Physics::Analytic::BoxBox
+							(lhs.GetBounding<BoundingOrientedBox>(), rhs.GetBounding<BoundingOrientedBox>(), out);
+				},
+				[](const Collider& lhs, const Collider& rhs, Physics::Penetration& out)
+				{
+					return Physics::Analytic::BoxSphere
+							(lhs.GetBounding<BoundingOrientedBox>(), rhs.GetBounding<BoundingSphere>(), out);
+				}
+			},
+			{
+				[](const Collider& lhs, const Collider& rhs, Physics::Penetration& out)
+				{
+					return Physics::Analytic::SphereBox
+							(lhs.GetBounding<BoundingSphere>(), rhs.GetBounding<BoundingOrientedBox>(), out);
+				},
+				[](const Collider& lhs, const Collider& rhs, Physics::Penetration& out)
+				{
+					return Physics::Analytic::SphereSphere
+							(lhs.GetBounding<BoundingSphere>(), rhs.GetBounding<BoundingSphere>(), out);
+				}
+			}
+		};
+	}
+
 	bool Collider::GetPenetration(
 		const Collider& other, Vector3& normal,
 		float&          depth
 	) const
 	{
+		// Only the hull of the mesh needs the GJK.
+		if (m_shape_.expired() && other.m_shape_.expired())
+		{
+			Physics::Penetration penetration;
+
+			if (!s_penetration_tests[m_type_][other.m_type_](*this, other, penetration))
+			{
+				return false;
+			}
+
+			normal = penetration.normal;
+			depth  = penetration.depth;
+			return true;
+		}
+
 		auto dir = other.GetWorldMatrix().Translation() - GetWorldMatrix().Translation();
 		dir.Normalize();
 
 		return Physics::GJK::GJKAlgorithm
 				(
-				 GetWorldMatrix(), other.GetWorldMatrix(), GetVertices(), other.GetVertices(), dir,
+				 GetWorldVertices(), other.GetWorldVertices(), dir,
 				 normal, depth
 				);
 	}
@@ -423,6 +520,9 @@ namespace Engine::Components
 				m_previous_world_matrix_ = new_world;
 			}
 		}
+#else
+		// Transforms the vertices once per step, the solver re-transforms only the objects it moves.
+		GetWorldVertices();
 #endif
 	}
 
@@ -443,6 +543,7 @@ namespace Engine::Components
 		Component::OnDeserialized();
 
 		InitializeStockVertices();
+		UpdateHull();
 		m_shape_meta_path_ = m_shape_meta_path_str_;
 
 		if (!m_shape_meta_path_.empty())
@@ -478,6 +579,42 @@ namespace Engine::Components
 		return m_boundings_.Transform(GetWorldMatrix());
 	}
 
+	void Collider::NotifyBoundsChange() const
+	{
+		m_world_vertices_dirty_ = true;
+
+		if (const auto owner = GetOwner().lock())
+		{
+			if (const auto transform = owner->GetComponent<Transform>().lock())
+			{
+				transform->NotifyMoved();
+			}
+		}
+	}
+
+	void Collider::UpdateHull() const
+	{
+		if (const auto model = m_shape_.lock())
+		{
+			m_hull_           = model->GetHull();
+			m_shape_revision_ = model->GetRevision();
+		}
+		else if (m_type_ == BOUNDING_TYPE_BOX)
+		{
+			m_hull_ = s_cube_stock_hull_;
+		}
+		else if (m_type_ == BOUNDING_TYPE_SPHERE)
+		{
+			m_hull_ = s_sphere_stock_hull_;
+		}
+		else
+		{
+			m_hull_.reset();
+		}
+
+		m_world_vertices_dirty_ = true;
+	}
+
 	void Collider::UpdateInertiaTensor()
 	{
 		Quaternion rotation;
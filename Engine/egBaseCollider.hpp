@@ -4,6 +4,7 @@
 #include "egGenericBounding.hpp"
 #include "egHelper.hpp"
 #include "egDelegate.hpp"
+#include "egPhysics.hpp"
 #include "egTransform.h"
 
 #ifdef PHYSX_ENABLED
@@ -67,6 +68,8 @@ namespace Engine::Components
 		eBoundingType GetType() const;
 
 		const std::vector<Graphics::VertexElement>& GetVertices() const;
+		// Vertices in the world space, transformed again only if the world matrix has changed. Not thread-safe.
+		const Physics::WorldVertexCollection&       GetWorldVertices() const;
 		Matrix                                      GetWorldMatrix() const;
 		virtual Matrix                              GetLocalMatrix() const;
 
@@ -130,6 +133,10 @@ namespace Engine::Components
 		static void InitializeStockVertices();
 
 		void UpdateInertiaTensor();
+		// Hull of the shape, or of the stock vertices of the type.
+		void UpdateHull() const;
+		// World bounds are changed without moving the transform.
+		void NotifyBoundsChange() const;
 		void GenerateInertiaCube();
 		void GenerateInertiaSphere();
 		void VerifyMaterial(boost::weak_ptr<Resources::Material> weak);
@@ -148,6 +155,8 @@ namespace Engine::Components
 		inline static std::vector<Graphics::VertexElement> s_sphere_stock_ = {};
 		inline static std::vector<UINT> s_cube_stock_indices_ = {};
 		inline static std::vector<UINT> s_sphere_stock_indices_ = {};
+		inline static boost::shared_ptr<const Physics::ConvexHull> s_cube_stock_hull_   = {};
+		inline static boost::shared_ptr<const Physics::ConvexHull> s_sphere_stock_hull_ = {};
 		static constexpr const char* s_stock_shape_names[] = 
 		{
 			"Cube",
@@ -165,6 +174,16 @@ namespace Engine::Components
 
 		WeakModel m_shape_;
 
+		// Non-serialized, convex hull of the vertices with the adjacency, built when the shape is set. Refreshed
+		// if the revision of the shape is changed.
+		mutable boost::shared_ptr<const Physics::ConvexHull> m_hull_;
+		mutable UINT                                         m_shape_revision_ = 0;
+
+		// Non-serialized, cache of the world vertices and the world matrix of the cache.
+		mutable Physics::WorldVertexCollection m_world_vertices_;
+		mutable Matrix                         m_world_vertices_matrix_;
+		mutable bool                           m_world_vertices_dirty_ = true;
+
 #ifdef PHYSX_ENABLED
 	private:
 		friend class Rigidbody;
@@ -0,0 +1,288 @@
+#include "pch.h"
+#include "egBenchmark.hpp"
+
+#include "egFriction.h"
+#include "egManagerHelper.hpp"
+#include "egOctree.hpp"
+#include "egSceneManager.hpp"
+
+namespace Engine::Benchmark
+{
+	namespace
+	{
+		template <typename F>
+		double Measure(F&& func)
+		{
+			using clock = std::chrono::steady_clock;
+
+			const auto start = clock::now();
+			func();
+			return std::chrono::duration<double, std::milli>(clock::now() - start).count();
+		}
+
+		struct BodyState
+		{
+			Vector3    position;
+			Quaternion orientation;
+			Vector3    linear_velocity;
+			Vector3    angular_velocity;
+			Vector3    force;
+			Vector3    torque;
+			float      friction;
+		};
+
+		// Integration steps of PhysicsManager::UpdateObject.
+		void Integrate(BodyState& body, const float dt)
+		{
+			Vector3 lvel = body.linear_velocity;
+
+			const Vector3 lfrc = Physics::EvalFriction(lvel, body.friction, dt);
+
+			lvel += lfrc;
+			Physics::FrictionVelocityGuard(lvel, lfrc);
+
+			body.position += Physics::EvalT1PositionDelta(lvel, body.force, dt);
+
+			body.orientation += Quaternion{Physics::EvalT1PositionDelta(body.angular_velocity, body.torque, dt), 1.0f} *
+					body.orientation;
+			body.orientation.Normalize();
+
+			body.angular_velocity = Physics::EvalT1Velocity(body.angular_velocity, body.torque, Vector3::Zero, dt);
+			body.linear_velocity  = Physics::EvalT1Velocity(lvel, body.force, Vector3::Zero, dt);
+		}
+	}
+
+	Result TaskSubmission(const size_t count)
+	{
+		// Tasks are empty and drained at the next frame.
+		Result result{};
+
+		result.baseline_ms = Measure
+				(
+				 [count]()
+				 {
+					 for (size_t i = 0; i < count; ++i)
+					 {
+						 GetTaskScheduler().AddTask
+								 (
+								  TASK_NONE, {i}, [](const std::vector<std::any>&, const float) {}
+								 );
+					 }
+				 }
+				);
+
+		result.current_ms = Measure
+				(
+				 [count]()
+				 {
+					 for (size_t i = 0; i < count; ++i)
+					 {
+						 GetTaskScheduler().AddTask
+								 (
+								  TASK_NONE, [](const size_t, const float) {}, i
+								 );
+					 }
+				 }
+				);
+
+		return result;
+	}
+
+	Result RigidbodyIntegration(const size_t count)
+	{
+		constexpr float dt    = g_fixed_update_interval;
+		constexpr int   steps = 10;
+
+		std::vector<BodyState> serial(count);
+
+		for (size_t i = 0; i < count; ++i)
+		{
+			const float f = static_cast<float>(i);
+
+			serial[i] = {
+				{f, f * 0.5f, -f}, Quaternion::Identity, {std::sinf(f), 1.f, std::cosf(f)}, {0.f, 0.1f, 0.f},
+				{0.f, -g_gravity_acc, 0.f}, {0.01f, 0.f, 0.f}, 0.1f
+			};
+		}
+
+		std::vector<BodyState> parallel = serial;
+		Result                 result{};
+
+		result.baseline_ms = Measure
+				(
+				 [&serial, dt]()
+				 {
+					 for (int step = 0; step < steps; ++step)
+					 {
+						 for (auto& body : serial)
+						 {
+							 Integrate(body, dt);
+						 }
+					 }
+				 }
+				);
+
+		result.current_ms = Measure
+				(
+				 [&parallel, dt]()
+				 {
+					 for (int step = 0; step < steps; ++step)
+					 {
+						 GetTaskScheduler().ParallelFor
+								 (
+								  parallel.size(), [&parallel, dt](const size_t i)
+								  {
+									  Integrate(parallel[i], dt);
+								  }, g_rigidbody_parallel_grain
+								 );
+					 }
+				 }
+				);
+
+		for (size_t i = 0; i < count; ++i)
+		{
+			if (std::memcmp(&serial[i], &parallel[i], sizeof(BodyState)) != 0)
+			{
+				++result.mismatches;
+			}
+		}
+
+		return result;
+	}
+
+	Result SingletonAccess(const size_t count)
+	{
+		std::mutex          lock;
+		std::atomic<size_t> baseline_sink = 0;
+		std::atomic<size_t> current_sink  = 0;
+		Result              result{};
+
+		// Instance is published before the measurement.
+		GetDebugger();
+
+		result.baseline_ms = Measure
+				(
+				 [&]()
+				 {
+					 tbb::parallel_for
+							 (
+							  tbb::blocked_range<size_t>(0, count), [&](const tbb::blocked_range<size_t>& range)
+							  {
+								  size_t sink = 0;
+
+								  for (size_t i = range.begin(); i != range.end(); ++i)
+								  {
+									  std::lock_guard l(lock);
+									  sink ^= reinterpret_cast<size_t>(&GetDebugger());
+								  }
+
+								  baseline_sink ^= sink;
+							  }
+							 );
+				 }
+				);
+
+		result.current_ms = Measure
+				(
+				 [&]()
+				 {
+					 tbb::parallel_for
+							 (
+							  tbb::blocked_range<size_t>(0, count), [&](const tbb::blocked_range<size_t>& range)
+							  {
+								  size_t sink = 0;
+
+								  for (size_t i = range.begin(); i != range.end(); ++i)
+								  {
+									  sink ^= reinterpret_cast<size_t>(&GetDebugger());
+								  }
+
+								  current_sink ^= sink;
+							  }
+							 );
+				 }
+				);
+
+		// Both paths should see the same instance.
+		result.mismatches = baseline_sink != current_sink;
+
+		return result;
+	}
+
+	Result OctreeNearest(const size_t queries, const float distance)
+	{
+		Result result{};
+
+		const auto scene = GetSceneManager().GetActiveScene().lock();
+
+		if (!scene)
+		{
+			return result;
+		}
+
+		std::vector<SpatialIndex::WeakT> objects;
+		std::vector<BoundingBox>         bounds;
+
+		scene->GetObjectTree().ForEachBounds
+				(
+				 [&objects, &bounds](GlobalEntityID, const SpatialIndex::WeakT& obj, const BoundingBox& box)
+				 {
+					 objects.push_back(obj);
+					 bounds.push_back(box);
+				 }
+				);
+
+		if (objects.empty())
+		{
+			return result;
+		}
+
+		Octree octree;
+		octree.Build(objects);
+
+		// Queries around the objects, so that both paths find something.
+		std::vector<Vector3> points(queries);
+
+		for (size_t i = 0; i < queries; ++i)
+		{
+			points[i] = Vector3(bounds[i % bounds.size()].Center) + Vector3(static_cast<float>(i % 7) - 3.f, 0.f, 0.f);
+		}
+
+		std::vector<size_t> linear_counts(queries);
+		std::vector<size_t> octree_counts(queries);
+
+		result.baseline_ms = Measure
+				(
+				 [&]()
+				 {
+					 for (size_t i = 0; i < queries; ++i)
+					 {
+						 const BoundingSphere sphere(points[i], distance);
+
+						 for (const auto& box : bounds)
+						 {
+							 linear_counts[i] += box.Intersects(sphere);
+						 }
+					 }
+				 }
+				);
+
+		result.current_ms = Measure
+				(
+				 [&]()
+				 {
+					 for (size_t i = 0; i < queries; ++i)
+					 {
+						 octree_counts[i] = octree.Nearest(points[i], distance).size();
+					 }
+				 }
+				);
+
+		for (size_t i = 0; i < queries; ++i)
+		{
+			result.mismatches += linear_counts[i] != octree_counts[i];
+		}
+
+		return result;
+	}
+}
@@ -0,0 +1,23 @@
+#pragma once
+
+namespace Engine::Benchmark
+{
+	// Elapsed time of the same workload in the previous path and the current path.
+	struct Result
+	{
+		double baseline_ms;
+		double current_ms;
+		// Outputs of the current path that differ from the previous path.
+		size_t mismatches;
+	};
+
+	// Deferred task submissions, type-erased TaskValue path against the typed records in the arena.
+	Result TaskSubmission(size_t count = 100000);
+	// Rigidbody integration of the physics manager on the detached body states, serial against the parallel-for.
+	Result RigidbodyIntegration(size_t count = 10000);
+	// Manager access under tbb::parallel_for, mutex guarded lookup of the previous singleton against the
+	// published instance.
+	Result SingletonAccess(size_t count = 1000000);
+	// Radius queries on the objects of the active scene, linear scan of the bounds against the octree.
+	Result OctreeNearest(size_t queries = 10000, float distance = 5.f);
+}
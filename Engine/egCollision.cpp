@@ -1,5 +1,6 @@
 #include "pch.h"
 #include "egCollision.h"
+#include "egConvexHull.hpp"
 #include "egElastic.h"
 #include "egPhysics.hpp"
 
@@ -12,51 +13,152 @@ namespace Engine::Physics { namespace GJK
 			return direction.Dot(ao) > 0.f;
 		}
 
-		Vector3 __vectorcall GetFurthestPoint(
-			const VertexCollection& points,
-			const Matrix&           world, const Vector3& dir
-		)
+		Vector3 __vectorcall GetFurthestPointScalar(const WorldVertexCollection& points, const Vector3& dir)
 		{
-			float                       max = -FLT_MAX;
-			Vector3                     result;
-			static std::vector<Vector3> out_stream;
+			float  max   = -FLT_MAX;
+			size_t index = 0;
 
-			if (out_stream.size() < points.size())
+			for (size_t i = 0; i < points.count; ++i)
 			{
-				out_stream.resize(points.size());
+				const float dist = points.x[i] * dir.x + points.y[i] * dir.y + points.z[i] * dir.z;
+
+				if (dist > max)
+				{
+					max   = dist;
+					index = i;
+				}
 			}
 
-			XMVector3TransformCoordStream
-					(
-					 out_stream.data(), sizeof(Vector3),
-					 reinterpret_cast<const Vector3*>(points.data()),
-					 sizeof(Graphics::VertexElement),
-					 points.size(), world
-					);
+			return {points.x[index], points.y[index], points.z[index]};
+		}
 
-			for (int i = 0; i < points.size(); ++i)
+		Vector3 __vectorcall GetFurthestPointAVX(const WorldVertexCollection& points, const Vector3& dir)
+		{
+			const __m256  dx   = _mm256_set1_ps(dir.x);
+			const __m256  dy   = _mm256_set1_ps(dir.y);
+			const __m256  dz   = _mm256_set1_ps(dir.z);
+			const __m256i step = _mm256_set1_epi32(8);
+
+			__m256  max     = _mm256_set1_ps(-FLT_MAX);
+			__m256i max_idx = _mm256_setzero_si256();
+			__m256i idx     = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+
+			for (size_t i = 0; i < points.x.size(); i += 8)
 			{
-				const float dist = out_stream[i].Dot(dir);
+				const __m256 dist = _mm256_add_ps
+						(
+						 _mm256_mul_ps(_mm256_loadu_ps(points.x.data() + i), dx),
+						 _mm256_add_ps
+						 (
+						  _mm256_mul_ps(_mm256_loadu_ps(points.y.data() + i), dy),
+						  _mm256_mul_ps(_mm256_loadu_ps(points.z.data() + i), dz)
+						 )
+						);
 
-				if (dist > max)
+				// Strictly greater, the earlier vertex is kept in the lane as the scalar scan does.
+				const __m256 mask = _mm256_cmp_ps(dist, max, _CMP_GT_OQ);
+
+				max     = _mm256_blendv_ps(max, dist, mask);
+				max_idx = _mm256_blendv_epi8(max_idx, idx, _mm256_castps_si256(mask));
+				idx     = _mm256_add_epi32(idx, step);
+			}
+
+			alignas(32) float lane_max[8];
+			alignas(32) int   lane_idx[8];
+
+			_mm256_store_ps(lane_max, max);
+			_mm256_store_si256(reinterpret_cast<__m256i*>(lane_idx), max_idx);
+
+			int index = lane_idx[0];
+
+			for (int i = 1; i < 8; ++i)
+			{
+				if (lane_max[i] > lane_max[0] || (lane_max[i] == lane_max[0] && lane_idx[i] < index))
+				{
+					lane_max[0] = lane_max[i];
+					index       = lane_idx[i];
+				}
+			}
+
+			return {points.x[index], points.y[index], points.z[index]};
+		}
+
+		// Last results of the support mapping of the query, where the next climb starts. Kept per query so that
+		// the same collider can be tested by the multiple pairs at once.
+		struct SupportHint
+		{
+			UINT lhs = 0;
+			UINT rhs = 0;
+		};
+
+		// Climbs the hull adjacency from the last result, the local maximum of the convex hull is the global one.
+		Vector3 __vectorcall GetFurthestPointClimb(const WorldVertexCollection& points, const Vector3& dir, UINT& hint)
+		{
+			const auto& offsets   = points.hull->adjacency_offsets;
+			const auto& adjacency = points.hull->adjacency;
+
+			const auto dot = [&points, &dir](const UINT i)
+			{
+				return points.x[i] * dir.x + points.y[i] * dir.y + points.z[i] * dir.z;
+			};
+
+			UINT  current = hint < points.count ? hint : 0;
+			float max     = dot(current);
+
+			for (bool climbed = true; climbed;)
+			{
+				climbed = false;
+
+				const UINT from = current;
+
+				for (UINT i = offsets[from]; i < offsets[from + 1]; ++i)
 				{
-					max    = dist;
-					result = out_stream[i];
+					const float dist = dot(adjacency[i]);
+
+					if (dist > max)
+					{
+						max     = dist;
+						current = adjacency[i];
+						climbed = true;
+					}
 				}
 			}
 
-			return result;
+			hint = current;
+
+			return {points.x[current], points.y[current], points.z[current]};
+		}
+
+		Vector3 __vectorcall GetFurthestPoint(const WorldVertexCollection& points, const Vector3& dir, UINT& hint)
+		{
+			if (points.count == 0)
+			{
+				return Vector3::Zero;
+			}
+
+			// Scan is cheaper for the small hulls.
+			if (points.hull && points.hull->HasAdjacency() && points.count > g_gjk_hill_climb_threshold)
+			{
+				return GetFurthestPointClimb(points, dir, hint);
+			}
+
+			if (check_avx())
+			{
+				return GetFurthestPointAVX(points, dir);
+			}
+
+			return GetFurthestPointScalar(points, dir);
 		}
 
 		Vector3 __vectorcall GetSupportPoint(
-			const VertexCollection& lhs,
-			const VertexCollection& rhs,
-			const Matrix&           lw, const Matrix& rw,
-			const Vector3&          dir
+			const WorldVertexCollection& lhs,
+			const WorldVertexCollection& rhs,
+			const Vector3&               dir,
+			SupportHint&                 hint
 		)
 		{
-			const Vector3 support1 = GetFurthestPoint(lhs, lw, dir);
-			const Vector3 support2 = GetFurthestPoint(rhs, rw, -dir);
+			const Vector3 support1 = GetFurthestPoint(lhs, dir, hint.lhs);
+			const Vector3 support2 = GetFurthestPoint(rhs, -dir, hint.rhs);
 
 			return support1 - support2;
 		}
@@ -226,11 +328,10 @@ namespace Engine::Physics { namespace GJK
 		}
 
 		void __vectorcall EPAAlgorithm(
-			const VertexCollection& lhs,
-			const VertexCollection& rhs,
-			const Matrix&           lw, const Matrix& rw,
-			const Simplex&          simplex, Vector3& normal,
-			float&                  penetration
+			const WorldVertexCollection& lhs,
+			const WorldVertexCollection& rhs,
+			const Simplex&               simplex, Vector3& normal,
+			float&                       penetration, SupportHint& hint
 		)
 		{
 			const auto                    AddIfUnique = [](
@@ -274,7 +375,7 @@ namespace Engine::Physics { namespace GJK
 					break;
 				}
 
-				Vector3 support   = GetSupportPoint(lhs, rhs, lw, rw, minNormal);
+				Vector3 support   = GetSupportPoint(lhs, rhs, minNormal, hint);
 				float   sDistance = minNormal.Dot(support);
 
 				if (std::abs(sDistance - minDistance) <= g_epsilon)
@@ -357,18 +458,16 @@ namespace Engine::Physics { namespace GJK
 		}
 
 		bool __vectorcall GJKAlgorithm(
-			const Matrix&           lhs_world,
-			const Matrix&           rhs_world, const VertexCollection& lhs_vertices,
-			const VertexCollection& rhs_vertices, const Vector3&       dir,
-			Vector3&                normal, float&                     penetration
+			const WorldVertexCollection& lhs_vertices,
+			const WorldVertexCollection& rhs_vertices, const Vector3& dir,
+			Vector3&                     normal, float&               penetration
 		)
 		{
-			const Matrix& lw = lhs_world;
-			const Matrix& rw = rhs_world;
-			const auto&   lv = lhs_vertices;
-			const auto&   rv = rhs_vertices;
+			const auto& lv = lhs_vertices;
+			const auto& rv = rhs_vertices;
 
-			Vector3 support = GetSupportPoint(lv, rv, lw, rw, dir);
+			SupportHint hint;
+			Vector3     support = GetSupportPoint(lv, rv, dir, hint);
 
 			Simplex simplex;
 			simplex.push_front(support);
@@ -381,7 +480,7 @@ namespace Engine::Physics { namespace GJK
 			{
 				iteration++;
 
-				support = GetSupportPoint(lv, rv, lw, rw, origin_dir);
+				support = GetSupportPoint(lv, rv, origin_dir, hint);
 
 				if (support.Dot(origin_dir) <= 0)
 				{
@@ -392,7 +491,7 @@ namespace Engine::Physics { namespace GJK
 
 				if (NextSimplex(simplex, origin_dir))
 				{
-					EPAAlgorithm(lv, rv, lw, rw, simplex, normal, penetration);
+					EPAAlgorithm(lv, rv, simplex, normal, penetration, hint);
 
 					return true;
 				}
@@ -402,6 +501,276 @@ namespace Engine::Physics { namespace GJK
 		}
 	} // namespace GJK
 
+	namespace
+	{
+		// Transforms the positions into the lanes and pads them with the last vertex.
+		template <typename Range, typename Getter>
+		void TransformLanes(WorldVertexCollection& out, const Range& range, const Matrix& world, Getter&& getter)
+		{
+			out.count = range.size();
+
+			const size_t padded = (out.count + 7) & ~static_cast<size_t>(7);
+
+			out.x.resize(padded);
+			out.y.resize(padded);
+			out.z.resize(padded);
+
+			for (size_t i = 0; i < out.count; ++i)
+			{
+				const Vector3 position = Vector3::Transform(getter(range[i]), world);
+
+				out.x[i] = position.x;
+				out.y[i] = position.y;
+				out.z[i] = position.z;
+			}
+
+			for (size_t i = out.count; i < padded; ++i)
+			{
+				out.x[i] = out.x[out.count - 1];
+				out.y[i] = out.y[out.count - 1];
+				out.z[i] = out.z[out.count - 1];
+			}
+		}
+	}
+
+	void __vectorcall WorldVertexCollection::Transform(const VertexCollection& vertices, const Matrix& world)
+	{
+		hull.reset();
+
+		TransformLanes
+				(
+				 *this, vertices, world, [](const Graphics::VertexElement& vertex) -> const Vector3&
+				 {
+					 return vertex.position;
+				 }
+				);
+	}
+
+	void __vectorcall WorldVertexCollection::Transform(
+		const boost::shared_ptr<const ConvexHull>& convex, const Matrix& world
+	)
+	{
+		hull = convex;
+
+		TransformLanes
+				(
+				 *this, convex->vertices, world, [](const Vector3& vertex) -> const Vector3&
+				 {
+					 return vertex;
+				 }
+				);
+	}
+
+	namespace Analytic
+	{
+		// Local axes of the box in the world space.
+		inline void __vectorcall GetAxes(const BoundingOrientedBox& box, Vector3 (&axes)[3])
+		{
+			const Quaternion orientation = box.Orientation;
+
+			axes[0] = Vector3::Transform(Vector3::UnitX, orientation);
+			axes[1] = Vector3::Transform(Vector3::UnitY, orientation);
+			axes[2] = Vector3::Transform(Vector3::UnitZ, orientation);
+		}
+
+		// Furthest corner of the box in the direction.
+		inline Vector3 __vectorcall GetBoxSupport(
+			const BoundingOrientedBox& box, const Vector3 (&axes)[3], const Vector3& dir
+		)
+		{
+			const float extents[3] = {box.Extents.x, box.Extents.y, box.Extents.z};
+			Vector3     point      = box.Center;
+
+			for (int i = 0; i < 3; ++i)
+			{
+				point += axes[i] * (axes[i].Dot(dir) >= 0.f ? extents[i] : -extents[i]);
+			}
+
+			return point;
+		}
+
+		bool __vectorcall SphereSphere(const BoundingSphere& lhs, const BoundingSphere& rhs, Penetration& out)
+		{
+			const Vector3 lhs_center = lhs.Center;
+			const Vector3 delta      = Vector3(rhs.Center) - lhs_center;
+			const float   distance   = delta.Length();
+			const float   radii      = lhs.Radius + rhs.Radius;
+
+			if (distance >= radii)
+			{
+				return false;
+			}
+
+			// Concentric spheres have no direction, any axis separates them.
+			out.normal  = distance > g_epsilon ? delta / distance : Vector3::Up;
+			out.depth   = radii - distance;
+			out.contact = lhs_center + out.normal * (lhs.Radius - out.depth * 0.5f);
+
+			return true;
+		}
+
+		bool __vectorcall SphereBox(const BoundingSphere& lhs, const BoundingOrientedBox& rhs, Penetration& out)
+		{
+			Vector3 axes[3];
+			GetAxes(rhs, axes);
+
+			const Vector3 center     = lhs.Center;
+			const Vector3 delta      = center - Vector3(rhs.Center);
+			const float   extents[3] = {rhs.Extents.x, rhs.Extents.y, rhs.Extents.z};
+
+			float   local[3];
+			Vector3 closest = rhs.Center;
+			bool    inside  = true;
+
+			// Closest point of the box to the center of the sphere.
+			for (int i = 0; i < 3; ++i)
+			{
+				local[i] = delta.Dot(axes[i]);
+
+				const float clamped = std::clamp(local[i], -extents[i], extents[i]);
+
+				if (clamped != local[i])
+				{
+					inside = false;
+				}
+
+				closest += axes[i] * clamped;
+			}
+
+			if (!inside)
+			{
+				const Vector3 to_box   = closest - center;
+				const float   distance = to_box.Length();
+
+				if (distance >= lhs.Radius)
+				{
+					return false;
+				}
+
+				out.normal  = to_box / distance;
+				out.depth   = lhs.Radius - distance;
+				out.contact = closest;
+
+				return true;
+			}
+
+			// Center is inside the box, pushed out through the nearest face.
+			int   axis = 0;
+			float face = extents[0] - std::fabsf(local[0]);
+
+			for (int i = 1; i < 3; ++i)
+			{
+				if (extents[i] - std::fabsf(local[i]) < face)
+				{
+					axis = i;
+					face = extents[i] - std::fabsf(local[i]);
+				}
+			}
+
+			const float sign = local[axis] >= 0.f ? 1.f : -1.f;
+
+			out.normal  = axes[axis] * -sign;
+			out.depth   = lhs.Radius + face;
+			out.contact = center + axes[axis] * (sign * face);
+
+			return true;
+		}
+
+		bool __vectorcall BoxSphere(const BoundingOrientedBox& lhs, const BoundingSphere& rhs, Penetration& out)
+		{
+			if (!SphereBox(rhs, lhs, out))
+			{
+				return false;
+			}
+
+			out.normal = -out.normal;
+			return true;
+		}
+
+		bool __vectorcall BoxBox(const BoundingOrientedBox& lhs, const BoundingOrientedBox& rhs, Penetration& out)
+		{
+			// Edge axis is taken only if it is clearly shallower, the face contact is more stable.
+			constexpr float edge_bias = 1.05f;
+
+			Vector3 lhs_axes[3];
+			Vector3 rhs_axes[3];
+			GetAxes(lhs, lhs_axes);
+			GetAxes(rhs, rhs_axes);
+
+			const Vector3 delta          = Vector3(rhs.Center) - Vector3(lhs.Center);
+			const float   lhs_extents[3] = {lhs.Extents.x, lhs.Extents.y, lhs.Extents.z};
+			const float   rhs_extents[3] = {rhs.Extents.x, rhs.Extents.y, rhs.Extents.z};
+
+			float   min_overlap = FLT_MAX;
+			Vector3 min_axis;
+
+			// Returns false if the axis separates the boxes.
+			const auto test = [&](Vector3 axis, const float bias)
+			{
+				const float length = axis.Length();
+
+				// Parallel edges give no axis, the face axes cover them.
+				if (length < g_epsilon)
+				{
+					return true;
+				}
+
+				axis /= length;
+
+				float lhs_radius = 0.f;
+				float rhs_radius = 0.f;
+
+				for (int i = 0; i < 3; ++i)
+				{
+					lhs_radius += std::fabsf(lhs_axes[i].Dot(axis)) * lhs_extents[i];
+					rhs_radius += std::fabsf(rhs_axes[i].Dot(axis)) * rhs_extents[i];
+				}
+
+				const float distance = delta.Dot(axis);
+				const float overlap  = lhs_radius + rhs_radius - std::fabsf(distance);
+
+				if (overlap < 0.f)
+				{
+					return false;
+				}
+
+				if (overlap * bias < min_overlap)
+				{
+					min_overlap = overlap;
+					min_axis    = distance < 0.f ? -axis : axis;
+				}
+
+				return true;
+			};
+
+			for (int i = 0; i < 3; ++i)
+			{
+				if (!test(lhs_axes[i], 1.f) || !test(rhs_axes[i], 1.f))
+				{
+					return false;
+				}
+			}
+
+			for (int i = 0; i < 3; ++i)
+			{
+				for (int j = 0; j < 3; ++j)
+				{
+					if (!test(lhs_axes[i].Cross(rhs_axes[j]), edge_bias))
+					{
+						return false;
+					}
+				}
+			}
+
+			out.normal = min_axis;
+			out.depth  = min_overlap;
+			// Midpoint of the deepest corners of the boxes along the normal.
+			out.contact = (GetBoxSupport(lhs, lhs_axes, min_axis) + GetBoxSupport(rhs, rhs_axes, -min_axis)) * 0.5f;
+
+			return true;
+		}
+	} // namespace Analytic
+
 	namespace Raycast
 	{
 		inline bool __vectorcall TestAxis(
@@ -1,16 +1,34 @@
 #pragma once
 #include "egType.h"
+#include "egPhysics.hpp"
 
 namespace Engine::Physics { namespace GJK
 	{
 		bool __vectorcall GJKAlgorithm(
-			const Matrix&           lhs_world,
-			const Matrix&           rhs_world, const VertexCollection& lhs_vertices,
-			const VertexCollection& rhs_vertices, const Vector3&       dir,
-			Vector3&                normal, float&                     penetration
+			const WorldVertexCollection& lhs_vertices,
+			const WorldVertexCollection& rhs_vertices, const Vector3& dir,
+			Vector3&                     normal, float&               penetration
 		);
 	} // namespace GJK
 
+	// Penetration of the pair, the normal points from lhs to rhs.
+	struct Penetration
+	{
+		Vector3 normal;
+		float   depth;
+		Vector3 contact;
+	};
+
+	// Closed form tests for the primitive pairs, used instead of the GJK if neither is a mesh.
+	namespace Analytic
+	{
+		bool __vectorcall SphereSphere(const BoundingSphere& lhs, const BoundingSphere& rhs, Penetration& out);
+		bool __vectorcall SphereBox(const BoundingSphere& lhs, const BoundingOrientedBox& rhs, Penetration& out);
+		bool __vectorcall BoxSphere(const BoundingOrientedBox& lhs, const BoundingSphere& rhs, Penetration& out);
+		// Separating axis test over the face normals and the edge cross products.
+		bool __vectorcall BoxBox(const BoundingOrientedBox& lhs, const BoundingOrientedBox& rhs, Penetration& out);
+	} // namespace Analytic
+
 	namespace Raycast
 	{
 		bool __vectorcall TestRayOBBIntersection(
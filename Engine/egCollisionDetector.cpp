@@ -19,6 +19,7 @@
 #include "egObject.hpp"
 #include "egRigidbody.h"
 #include "egSceneManager.hpp"
+#include "egSpatialIndex.hpp"
 #include "egTransform.h"
 
 namespace Engine::Manager::Physics
@@ -74,95 +75,53 @@ namespace Engine::Manager::Physics
 #else
 			const auto& tree = scene->GetObjectTree();
 
-			std::stack<const Octree*> stack;
-			stack.push(&tree);
+			BuildProxies(tree, dt);
+			BuildPairs(tree);
 
-			std::vector<std::vector<WeakObjectBase>> node_objects;
-			std::map<const Octree*, bool>            visited;
+			// Narrowphase does not write any shared state, each pair has its own slot of the result.
+			m_results_.resize(m_pairs_.size());
 
-			while (!stack.empty())
-			{
-				const auto  node     = stack.top();
-				const auto& value    = node->Read();
-				const auto& children = node->Next();
-				const auto& active   = node->ActiveChildren();
-
-				// Walk back from stack, it can be visited again.
-				if (visited.contains(node) && visited[node])
-				{
-					stack.pop();
-					continue;
-				}
+			GetTaskScheduler().ParallelFor
+					(
+					 m_pairs_.size(), [this, dt](const size_t i)
+					 {
+						 NarrowphaseResult& result = m_results_[i];
 
-				// Add children to stack.
-				for (int i = 7; i >= 0; --i)
-				{
-					if (children[i])
-					{
-						stack.push(children[i]);
-					}
-				}
-
-				// If it never visited, then check collision.
-				if (!visited[node])
-				{
-					// Self collision check
-					for (int i = 0; i < value.size(); ++i)
-					{
-						const auto& obj = value[i].lock();
-						if (!obj)
-						{
-							continue;
-						}
-						const auto& cl = obj->GetComponent<Components::Collider>().lock();
+						 result.lhs = m_proxies_[m_pairs_[i].first].object.lock();
+						 result.rhs = m_proxies_[m_pairs_[i].second].object.lock();
 
-						// If object is inactive or collider is inactive, then dispatch exit event.
-						if (obj && !obj->GetActive() || (cl && !cl->GetActive()))
-						{
-							DispatchInactiveExit(value[i]);
-						}
+						 if (!result.lhs || !result.rhs)
+						 {
+							 return;
+						 }
 
-						for (int j = i + 1; j < value.size(); ++j)
-						{
-							if constexpr (g_speculation_enabled)
-							{
-								TestSpeculation(value[i], value[j], dt);
-							}
-							TestCollision(value[i], value[j]);
-						}
-					}
+						 // Collision is tested regardless, the continuing speculative contact is queued by the collision.
+						 if constexpr (g_speculation_enabled)
+						 {
+							 TestSpeculation(result, dt);
+						 }
 
-					// Collision Check between parent and self
-					for (int i = 0; i < node_objects.size(); ++i)
-					{
-						const auto& parent_compare_set = node_objects[i];
+						 TestCollision(result);
+					 }, g_narrowphase_parallel_grain
+					);
 
-						for (int j = 0; j < value.size(); ++j)
-						{
-							for (int k = 0; k < parent_compare_set.size(); ++k)
-							{
-								if constexpr (g_speculation_enabled)
-								{
-									TestSpeculation(value[j], parent_compare_set[k], dt);
-								}
-								TestCollision(value[j], parent_compare_set[k]);
-							}
-						}
-					}
+			// Results are merged in the order of the pairs, the solver receives the same queue regardless of the
+			// thread count.
+			for (const NarrowphaseResult& result : m_results_)
+			{
+				if (result.speculation)
+				{
+					ApplySpeculation(result);
 				}
 
-				// Push back to comparison set.
-				node_objects.emplace_back(value);
-				// Mark as visited so that it doesn't initiate same collision check again.
-				visited[node] = true;
-
-				// terminal node
-				if (value.size() <= 1 && active == 0)
+				// Speculation caught the first contact of the pair in this pass.
+				if (result.tested && !IsCollidedInFrame(result.lhs->GetID(), result.rhs->GetID()))
 				{
-					node_objects.pop_back();
-					stack.pop();
+					ApplyCollision(result);
 				}
 			}
+
+			m_results_.clear();
 #endif
 		}
 
@@ -259,149 +218,172 @@ namespace Engine::Manager::Physics
 		}
 	}
 
-	void CollisionDetector::TestCollision(const WeakObjectBase& p_lhs, const WeakObjectBase& p_rhs)
+	void CollisionDetector::BuildProxies(const SpatialIndex& tree, const float dt)
+	{
+		m_proxies_.clear();
+		m_proxy_lookup_.clear();
+
+		tree.ForEachBounds
+				(
+				 [this, dt](const GlobalEntityID id, const WeakObjectBase& value, const BoundingBox& bounds)
+				 {
+					 const auto& obj = value.lock();
+					 if (!obj)
+					 {
+						 return;
+					 }
+					 const auto& cl = obj->GetComponent<Components::Collider>().lock();
+
+					 // If object is inactive or collider is inactive, then dispatch exit event.
+					 if (!obj->GetActive() || (cl && !cl->GetActive()))
+					 {
+						 DispatchInactiveExit(value);
+						 return;
+					 }
+
+					 if (!cl)
+					 {
+						 return;
+					 }
+
+					 BoundingBox swept = bounds;
+
+					 if constexpr (g_speculation_enabled)
+					 {
+						 // Speculation tests the displacement of the step, the bounds should cover it.
+						 if (const auto rb = obj->GetComponent<Components::Rigidbody>().lock())
+						 {
+							 const auto  delta = Engine::Physics::EvalT1PositionDelta
+									 (rb->GetT0LinearVelocity(), rb->GetT0Force(), dt);
+							 BoundingBox moved = bounds;
+							 moved.Center      = Vector3(bounds.Center) + delta;
+							 BoundingBox::CreateMerged(swept, bounds, moved);
+						 }
+					 }
+
+					 GlobalEntityID parent = g_invalid_id;
+
+					 if (const auto p = obj->GetParent().lock())
+					 {
+						 parent = p->GetID();
+					 }
+
+					 m_proxy_lookup_[id] = static_cast<UINT>(m_proxies_.size());
+					 m_proxies_.push_back({id, parent, obj->GetLayer(), swept, value});
+				 }
+				);
+	}
+
+	void CollisionDetector::BuildPairs(const SpatialIndex& tree)
 	{
-		const auto lhs = p_lhs.lock();
-		const auto rhs = p_rhs.lock();
+		m_pairs_.clear();
+
+		bool layer_mask[LAYER_MAX][LAYER_MAX];
 
-		if (!lhs || !rhs)
 		{
-			return;
+			std::lock_guard l(m_layer_mask_mutex_);
+			std::memcpy(layer_mask, m_layer_mask_, sizeof(layer_mask));
 		}
-		if (!IsCollisionLayer(lhs->GetLayer(), rhs->GetLayer()))
-		{
-			return;
-		}
-		if (lhs->GetParent().lock() || rhs->GetParent().lock())
+
+		const auto add = [this, &layer_mask](const GlobalEntityID lhs_id, const GlobalEntityID rhs_id, const bool overlap)
 		{
-			if (lhs->GetParent().lock() == rhs || rhs->GetParent().lock() == lhs)
+			const auto lit = m_proxy_lookup_.find(lhs_id);
+			const auto rit = m_proxy_lookup_.find(rhs_id);
+
+			// No collider or inactive.
+			if (lit == m_proxy_lookup_.end() || rit == m_proxy_lookup_.end())
 			{
 				return;
 			}
-			if (lhs->GetParent().lock() == rhs->GetParent().lock())
+
+			const BroadphaseProxy& lhs = m_proxies_[lit->second];
+			const BroadphaseProxy& rhs = m_proxies_[rit->second];
+
+			if (!layer_mask[lhs.layer][rhs.layer])
 			{
 				return;
 			}
-		}
-		if (!lhs->GetActive() || !rhs->GetActive())
-		{
-			return;
-		}
-
-		// Octree sanity check
-		if (lhs == rhs)
-		{
-			throw std::logic_error("Self collision detected");
-		}
-
-		// Speculation caught.
-		if (m_frame_collision_map_.contains(lhs->GetID()) &&
-		    m_frame_collision_map_[lhs->GetID()].contains(rhs->GetID()))
-		{
-			return;
-		}
-
-		const auto ltr = lhs->GetComponent<Components::Transform>().lock();
-		const auto rtr = rhs->GetComponent<Components::Transform>().lock();
-
-		const auto lcl = lhs->GetComponent<Components::Collider>().lock();
-		const auto rcl = rhs->GetComponent<Components::Collider>().lock();
-
-		if (lcl && rcl)
-		{
-			if (!lcl->GetActive() || !rcl->GetActive())
+			// Parent and child, or the siblings.
+			if (lhs.parent == rhs.id || rhs.parent == lhs.id)
 			{
 				return;
 			}
-			const bool collision = Components::Collider::Intersects(lcl, rcl);
-
-			if (collision)
+			if (lhs.parent != g_invalid_id && lhs.parent == rhs.parent)
 			{
-				if (!m_collision_map_.contains(lhs->GetID()) ||
-				    !m_collision_map_[lhs->GetID()].contains(rhs->GetID()))
-				{
-					// Initial Collision
-					m_frame_collision_map_[lhs->GetID()].insert(rhs->GetID());
-					m_frame_collision_map_[rhs->GetID()].insert(lhs->GetID());
-
-					lcl->onCollisionEnter.Broadcast(rcl);
-					rcl->onCollisionEnter.Broadcast(lcl);
-				}
-
-				const auto lrb = lhs->GetComponent<Components::Rigidbody>().lock();
-				const auto rrb = rhs->GetComponent<Components::Rigidbody>().lock();
-
-				if (lrb && rrb)
-				{
-					m_collision_produce_queue_.push_back({lhs, rhs, false, true});
-				}
+				return;
+			}
+			if (overlap && !lhs.bounds.Intersects(rhs.bounds))
+			{
+				return;
+			}
 
-				// Or continuous collision
-				lcl->AddCollidedObject(rhs->GetID());
-				rcl->AddCollidedObject(lhs->GetID());
+			if (lhs.id < rhs.id)
+			{
+				m_pairs_.emplace_back(lit->second, rit->second);
 			}
 			else
 			{
-				if (m_collision_map_.contains(lhs->GetID()) &&
-				    m_collision_map_[lhs->GetID()].contains(rhs->GetID()))
+				m_pairs_.emplace_back(rit->second, lit->second);
+			}
+		};
+
+		tree.QueryPairs
+				(
+				 [&add](const GlobalEntityID lhs, const GlobalEntityID rhs)
+				 {
+					 add(lhs, rhs, true);
+				 }
+				);
+
+		// Colliding pairs are tested even if the bounds no longer overlap, otherwise the exit event is missed.
+		for (const auto& [lhs, rhs_set] : m_collision_map_)
+		{
+			for (const auto& rhs : rhs_set)
+			{
+				if (lhs < rhs)
 				{
-					// Final Collision
-					m_collision_map_[lhs->GetID()].erase(rhs->GetID());
-					m_collision_map_[rhs->GetID()].erase(lhs->GetID());
-
-					lcl->onCollisionEnd.Broadcast(rcl);
-					rcl->onCollisionEnd.Broadcast(lcl);
-					lcl->RemoveCollidedObject(rhs->GetID());
-					rcl->RemoveCollidedObject(lhs->GetID());
+					add(lhs, rhs, false);
 				}
-
-				// No collision
 			}
 		}
+
+		std::ranges::sort
+				(
+				 m_pairs_, [this](const CandidatePair& a, const CandidatePair& b)
+				 {
+					 return std::tie(m_proxies_[a.first].id, m_proxies_[a.second].id) <
+					        std::tie(m_proxies_[b.first].id, m_proxies_[b.second].id);
+				 }
+				);
+
+		const auto [first, last] = std::ranges::unique(m_pairs_);
+		m_pairs_.erase(first, last);
 	}
 
-	void CollisionDetector::TestSpeculation(const WeakObjectBase& p_lhs, const WeakObjectBase& p_rhs, const float dt)
+	bool CollisionDetector::TestCollision(NarrowphaseResult& result) const
 	{
-		auto lhs = p_lhs.lock();
-		auto rhs = p_rhs.lock();
+		const auto lcl = result.lhs->GetComponent<Components::Collider>().lock();
+		const auto rcl = result.rhs->GetComponent<Components::Collider>().lock();
 
-		if (!lhs || !rhs)
+		if (!lcl || !rcl)
 		{
-			return;
-		}
-		if (!IsCollisionLayer(lhs->GetLayer(), rhs->GetLayer()))
-		{
-			return;
-		}
-		if (lhs->GetParent().lock() || rhs->GetParent().lock())
-		{
-			if (lhs->GetParent().lock() == rhs || rhs->GetParent().lock() == lhs)
-			{
-				return;
-			}
-			if (lhs->GetParent().lock() == rhs->GetParent().lock())
-			{
-				return;
-			}
+			return false;
 		}
-		if (!lhs->GetActive() || !rhs->GetActive())
+		if (!lcl->GetActive() || !rcl->GetActive())
 		{
-			return;
+			return false;
 		}
 
-		// Octree sanity check
-		if (lhs == rhs)
-		{
-			throw std::logic_error("Self collision detected");
-		}
-		if (m_frame_collision_map_.contains(lhs->GetID()) &&
-		    m_frame_collision_map_[lhs->GetID()].contains(rhs->GetID()))
-		{
-			throw std::logic_error("Double check occurred");
-		}
+		result.tested    = true;
+		result.collision = Components::Collider::Intersects(lcl, rcl);
+
+		return result.collision;
+	}
 
-		auto ltr = lhs->GetComponent<Components::Transform>().lock();
-		auto rtr = rhs->GetComponent<Components::Transform>().lock();
+	bool CollisionDetector::TestSpeculation(NarrowphaseResult& result, const float dt) const
+	{
+		auto lhs = result.lhs;
+		auto rhs = result.rhs;
 
 		auto lcl = lhs->GetComponent<Components::Collider>().lock();
 		auto rcl = rhs->GetComponent<Components::Collider>().lock();
@@ -413,13 +395,12 @@ namespace Engine::Manager::Physics
 		// Assuming lhs always has the rigid-body or both have, for moving object backward easily.
 		if (!lrb && !rrb)
 		{
-			return;
+			return false;
 		}
 		// Move rigid-body object to lhs or fixed object to rhs.
 		if ((rrb && !lrb) || (lrb && lrb->IsFixed()))
 		{
 			std::swap(lhs, rhs);
-			std::swap(ltr, rtr);
 			std::swap(lcl, rcl);
 			std::swap(lrb, rrb);
 		}
@@ -427,7 +408,7 @@ namespace Engine::Manager::Physics
 		// If rhs was not exist, then skip.
 		if (!lrb)
 		{
-			return;
+			return false;
 		}
 
 		if (lcl && rcl)
@@ -435,7 +416,7 @@ namespace Engine::Manager::Physics
 			// If any of object collider is disabled, then skip.
 			if (!lcl->GetActive() || !rcl->GetActive())
 			{
-				return;
+				return false;
 			}
 
 			bool collision1 = false;
@@ -471,30 +452,115 @@ namespace Engine::Manager::Physics
 			// If any of collision is true, then it is speculative hit.
 			if (collision1 || collision2)
 			{
-				//GetDebugger().Log(std::format("Speculative hit, {}, {}", lhs->GetName(), rhs->GetName()));
+				// Order of the speculation is kept for the solver.
+				result.swapped     = lhs != result.lhs;
+				result.speculation = true;
+				return true;
+			}
+		}
 
-				if (!m_collision_map_.contains(lhs->GetID()) ||
-				    !m_collision_map_[lhs->GetID()].contains(rhs->GetID()))
-				{
-					// Initial Collision
-					m_frame_collision_map_[lhs->GetID()].insert(rhs->GetID());
-					m_frame_collision_map_[rhs->GetID()].insert(lhs->GetID());
+		return false;
+	}
 
-					lcl->onCollisionEnter.Broadcast(rcl);
-					rcl->onCollisionEnter.Broadcast(lcl);
+	void CollisionDetector::ApplyCollision(const NarrowphaseResult& result)
+	{
+		const auto& lhs = result.lhs;
+		const auto& rhs = result.rhs;
 
-					m_collision_produce_queue_.push_back({lhs, rhs, true, true});
-				}
+		// Broadphase sanity check
+		if (lhs == rhs)
+		{
+			throw std::logic_error("Self collision detected");
+		}
+
+		const auto lcl = lhs->GetComponent<Components::Collider>().lock();
+		const auto rcl = rhs->GetComponent<Components::Collider>().lock();
+
+		if (result.collision)
+		{
+			if (!m_collision_map_.contains(lhs->GetID()) ||
+			    !m_collision_map_[lhs->GetID()].contains(rhs->GetID()))
+			{
+				// Initial Collision
+				m_frame_collision_map_[lhs->GetID()].insert(rhs->GetID());
+				m_frame_collision_map_[rhs->GetID()].insert(lhs->GetID());
+
+				lcl->onCollisionEnter.Broadcast(rcl);
+				rcl->onCollisionEnter.Broadcast(lcl);
+			}
+
+			const auto lrb = lhs->GetComponent<Components::Rigidbody>().lock();
+			const auto rrb = rhs->GetComponent<Components::Rigidbody>().lock();
+
+			if (lrb && rrb)
+			{
+				m_collision_produce_queue_.push_back({lhs, rhs, false, true});
+			}
+
+			// Or continuous collision
+			lcl->AddCollidedObject(rhs->GetID());
+			rcl->AddCollidedObject(lhs->GetID());
+		}
+		else
+		{
+			if (m_collision_map_.contains(lhs->GetID()) &&
+			    m_collision_map_[lhs->GetID()].contains(rhs->GetID()))
+			{
+				// Final Collision
+				m_collision_map_[lhs->GetID()].erase(rhs->GetID());
+				m_collision_map_[rhs->GetID()].erase(lhs->GetID());
 
-				// Or continuous collision
 				lcl->onCollisionEnd.Broadcast(rcl);
 				rcl->onCollisionEnd.Broadcast(lcl);
-				lcl->AddCollidedObject(rhs->GetID());
-				rcl->AddCollidedObject(lhs->GetID());
+				lcl->RemoveCollidedObject(rhs->GetID());
+				rcl->RemoveCollidedObject(lhs->GetID());
 			}
+
+			// No collision
 		}
 	}
 
+	void CollisionDetector::ApplySpeculation(const NarrowphaseResult& result)
+	{
+		const auto& lhs = result.swapped ? result.rhs : result.lhs;
+		const auto& rhs = result.swapped ? result.lhs : result.rhs;
+
+		// Broadphase sanity check
+		if (lhs == rhs)
+		{
+			throw std::logic_error("Self collision detected");
+		}
+		if (m_frame_collision_map_.contains(lhs->GetID()) &&
+		    m_frame_collision_map_[lhs->GetID()].contains(rhs->GetID()))
+		{
+			throw std::logic_error("Double check occurred");
+		}
+
+		const auto lcl = lhs->GetComponent<Components::Collider>().lock();
+		const auto rcl = rhs->GetComponent<Components::Collider>().lock();
+
+		//GetDebugger().Log(std::format("Speculative hit, {}, {}", lhs->GetName(), rhs->GetName()));
+
+		if (!m_collision_map_.contains(lhs->GetID()) ||
+		    !m_collision_map_[lhs->GetID()].contains(rhs->GetID()))
+		{
+			// Initial Collision
+			m_frame_collision_map_[lhs->GetID()].insert(rhs->GetID());
+			m_frame_collision_map_[rhs->GetID()].insert(lhs->GetID());
+
+			lcl->onCollisionEnter.Broadcast(rcl);
+			rcl->onCollisionEnter.Broadcast(lcl);
+
+			m_collision_produce_queue_.push_back({lhs, rhs, true, true});
+		}
+
+		// Or continuous collision
+		lcl->onCollisionEnd.Broadcast(rcl);
+		rcl->onCollisionEnd.Broadcast(lcl);
+		lcl->AddCollidedObject(rhs->GetID());
+		rcl->AddCollidedObject(lhs->GetID());
+	}
+
 	void CollisionDetector::DispatchInactiveExit(const WeakObjectBase& lhs)
 	{
 		const auto lcl   = lhs.lock()->GetComponent<Components::Collider>().lock();
@@ -618,4 +684,15 @@ namespace Engine::Manager::Physics
 
 		return m_frame_collision_map_.at(id1).contains(id2);
 	}
+
+	ManagerAccess CollisionDetector::GetAccess(const eManagerPhase phase) const
+	{
+		switch (phase)
+		{
+		case MANAGER_PHASE_FIXED_UPDATE:
+			return g_manager_access_exclusive;
+		default:
+			return g_manager_access_none;
+		}
+	}
 } // namespace Engine::Manager
@@ -1,6 +1,8 @@
 #pragma once
 #include <array>
 #include <bitset>
+#include <unordered_map>
+#include <vector>
 
 #include "egCommon.hpp"
 #include "egManager.hpp"
@@ -27,6 +29,7 @@ namespace Engine::Manager::Physics
 		explicit CollisionDetector(SINGLETON_LOCK_TOKEN) {}
 
 		void Initialize() override;
+		ManagerAccess GetAccess(eManagerPhase phase) const override;
 		void Update(const float& dt) override;
 		void PreUpdate(const float& dt) override;
 		void PreRender(const float& dt) override;
@@ -51,8 +54,44 @@ namespace Engine::Manager::Physics
 		friend struct SingletonDeleter;
 		~CollisionDetector() override;
 
-		void TestCollision(const WeakObjectBase& p_lhs, const WeakObjectBase& p_rhs);
-		void TestSpeculation(const WeakObjectBase& p_lhs, const WeakObjectBase& p_rhs, float dt);
+		// State of the object read once per fixed update, the pairs are filtered with this instead of locking the
+		// objects again for every pair.
+		struct BroadphaseProxy
+		{
+			GlobalEntityID id;
+			GlobalEntityID parent;
+			eLayerType     layer;
+			// Bounds swept by the displacement of the step if the speculation is enabled.
+			BoundingBox    bounds;
+			WeakObjectBase object;
+		};
+
+		// Indices of the proxies, the first one has the smaller id.
+		using CandidatePair = std::pair<UINT, UINT>;
+
+		void BuildProxies(const SpatialIndex& tree, float dt);
+		// Collects the pairs that pass the layer and hierarchy filter and overlap, and the pairs that are colliding
+		// for the exit event. Sorted by the ids and without duplicates.
+		void BuildPairs(const SpatialIndex& tree);
+
+		// Outcome of the narrowphase of the pair, applied after every pair is tested.
+		struct NarrowphaseResult
+		{
+			StrongObjectBase lhs;
+			StrongObjectBase rhs;
+			bool             tested      = false;
+			bool             collision   = false;
+			bool             speculation = false;
+			// Speculation puts the object with the rigid-body on lhs.
+			bool swapped = false;
+		};
+
+		// Tests only, the pairs can be tested in parallel.
+		bool TestCollision(NarrowphaseResult& result) const;
+		bool TestSpeculation(NarrowphaseResult& result, float dt) const;
+		// Dispatches the events and queues the collision for the solver.
+		void ApplyCollision(const NarrowphaseResult& result);
+		void ApplySpeculation(const NarrowphaseResult& result);
 
 		void DispatchInactiveExit(const WeakObjectBase& lhs);
 
@@ -64,6 +103,11 @@ namespace Engine::Manager::Physics
 		concurrent_map<GlobalEntityID, std::set<GlobalEntityID>> m_collision_map_;
 		concurrent_map<GlobalEntityID, std::set<GlobalEntityID>> m_frame_collision_map_;
 
+		std::vector<BroadphaseProxy>             m_proxies_;
+		std::unordered_map<GlobalEntityID, UINT> m_proxy_lookup_;
+		std::vector<CandidatePair>               m_pairs_;
+		std::vector<NarrowphaseResult>           m_results_;
+
 #ifdef PHYSX_ENABLED
 	public:
 		uint32_t GetLayerFilter(const eLayerType layer) const;
@@ -7,14 +7,33 @@
 #include "egMaterial.h"
 #include "egModelRenderer.h"
 #include "egParticleRenderer.h"
+#include "egProjectionFrustum.h"
 #include "egRenderComponent.h"
 #include "egSceneManager.hpp"
 #include "egTransform.h"
 
 namespace Engine::Manager::Graphics
 {
+	static BoundingOrientedBox ExtractBounding(const StrongTransform& tr)
+	{
+		return {tr->GetWorldPosition(), tr->GetWorldScale() * 0.5f, tr->GetWorldRotation()};
+	}
+
+	static void AddCandidate(RenderMap& map, const eRenderComponentType type, const CandidateTuple& candidate)
+	{
+		RenderMap::accessor acc;
+
+		if (!map.find(acc, type))
+		{
+			map.insert(acc, type);
+		}
+
+		acc->second.push_back(candidate);
+	}
+
 	void __fastcall BuildRenderMap(
-		const WeakScene& w_scene, RenderMap out_map[SHADER_DOMAIN_MAX], std::atomic<UINT64>& instance_count
+		const WeakScene&     w_scene, RenderMap out_map[SHADER_DOMAIN_MAX],
+		std::atomic<UINT64>& instance_count, RenderMap out_visible[SHADER_DOMAIN_MAX]
 	)
 	{
 		instance_count = 0;
@@ -22,6 +41,11 @@ namespace Engine::Manager::Graphics
 		for (auto i = 0; i < SHADER_DOMAIN_MAX; ++i)
 		{
 			out_map[i].clear();
+
+			if (out_visible)
+			{
+				out_visible[i].clear();
+			}
 		}
 
 		// Pre-processing, Mapping the materials to the model renderers.
@@ -31,7 +55,7 @@ namespace Engine::Manager::Graphics
 
 			tbb::parallel_for_each
 					(
-					 rcs.begin(), rcs.end(), [&out_map, &instance_count](const WeakComponent& ptr_rc)
+					 rcs.begin(), rcs.end(), [&out_map, &instance_count, out_visible](const WeakComponent& ptr_rc)
 					 {
 						 // pointer sanity check
 						 if (ptr_rc.expired())
@@ -70,14 +94,28 @@ namespace Engine::Manager::Graphics
 							 return;
 						 }
 
+						 // Culled once here, the render pass draws the visible candidates as they are.
+						 RenderMap* visible = nullptr;
+
+						 if (out_visible && GetProjectionFrustum().CheckRender(obj->GetID(), ExtractBounding(tr)))
+						 {
+							 visible = out_visible;
+						 }
+
 						 switch (rc->GetRenderType())
 						 {
 						 case RENDER_COM_T_MODEL:
-							 PremapModelImpl(rc->GetSharedPtr<Components::ModelRenderer>(), out_map, instance_count);
+							 PremapModelImpl
+									 (
+									  rc->GetSharedPtr<Components::ModelRenderer>(), out_map, instance_count, visible
+									 );
 							 break;
 						 case RENDER_COM_T_PARTICLE:
 							 PremapParticleImpl
-									 (rc->GetSharedPtr<Components::ParticleRenderer>(), out_map, instance_count);
+									 (
+									  rc->GetSharedPtr<Components::ParticleRenderer>(), out_map, instance_count,
+									  visible
+									 );
 							 break;
 						 case RENDER_COM_T_UNK:
 						 default:
@@ -90,7 +128,7 @@ namespace Engine::Manager::Graphics
 
 	void PremapModelImpl(
 		const WeakModelRenderer& model_component, RenderMap out_map[SHADER_DOMAIN_MAX],
-		std::atomic<UINT64>&     instance_count
+		std::atomic<UINT64>&     instance_count, RenderMap out_visible[SHADER_DOMAIN_MAX]
 	)
 	{
 		if (const auto& mr = model_component.lock())
@@ -146,15 +184,6 @@ namespace Engine::Manager::Graphics
 
 				if (mtr->IsRenderDomain(domain))
 				{
-					auto& domain_map = out_map[domain];
-
-					RenderMap::accessor acc;
-
-					if (!domain_map.find(acc, RENDER_COM_T_MODEL))
-					{
-						domain_map.insert(acc, RENDER_COM_T_MODEL);
-					}
-
 					SBs::InstanceModelSB sb{};
 					sb.SetWorld(tr->GetWorldMatrix().Transpose());
 					sb.SetFrame(anim_frame);
@@ -167,7 +196,18 @@ namespace Engine::Manager::Graphics
 					sb.SetAtlasH(atlas_h);
 
 					// todo: stacking structured buffer data might be get large easily.
-					acc->second.push_back(std::make_tuple(obj, mtr, aligned_vector<SBs::InstanceSB>{sb}));
+					const CandidateTuple candidate = std::make_tuple
+							(
+							 obj, mtr, aligned_vector<SBs::InstanceSB>{sb}, obj->GetLayer(), ExtractBounding(tr)
+							);
+
+					AddCandidate(out_map[domain], RENDER_COM_T_MODEL, candidate);
+
+					if (out_visible)
+					{
+						AddCandidate(out_visible[domain], RENDER_COM_T_MODEL, candidate);
+					}
+
 					instance_count.fetch_add(1);
 				}
 			}
@@ -176,7 +216,7 @@ namespace Engine::Manager::Graphics
 
 	void PremapParticleImpl(
 		const WeakParticleRenderer& particle_component, RenderMap out_map[SHADER_DOMAIN_MAX],
-		std::atomic<UINT64>&        instance_count
+		std::atomic<UINT64>&        instance_count, RenderMap out_visible[SHADER_DOMAIN_MAX]
 	)
 	{
 		if (const auto& pr = particle_component.lock())
@@ -204,15 +244,6 @@ namespace Engine::Manager::Graphics
 						continue;
 					}
 
-					auto& domain_map = out_map[domain];
-
-					RenderMap::accessor acc;
-
-					if (!domain_map.find(acc, RENDER_COM_T_PARTICLE))
-					{
-						domain_map.insert(acc, RENDER_COM_T_PARTICLE);
-					}
-
 					if (pr->IsFollowOwner())
 					{
 						for (auto& particle : particles)
@@ -223,7 +254,18 @@ namespace Engine::Manager::Graphics
 						}
 					}
 
-					acc->second.push_back(std::make_tuple(obj, mtr, particles));
+					const CandidateTuple candidate = std::make_tuple
+							(
+							 obj, mtr, particles, obj->GetLayer(), ExtractBounding(tr)
+							);
+
+					AddCandidate(out_map[domain], RENDER_COM_T_PARTICLE, candidate);
+
+					if (out_visible)
+					{
+						AddCandidate(out_visible[domain], RENDER_COM_T_PARTICLE, candidate);
+					}
+
 					instance_count.fetch_add(particles.size());
 				}
 			}
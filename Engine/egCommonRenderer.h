@@ -2,18 +2,32 @@
 
 namespace Engine::Manager::Graphics
 {
-	using CandidateTuple = std::tuple<WeakObjectBase, WeakMaterial, aligned_vector<SBs::InstanceSB>>;
+	// Object, material, instance data and the object state at the extraction. (layer, world bounding box)
+	using CandidateTuple = std::tuple<WeakObjectBase, WeakMaterial, aligned_vector<SBs::InstanceSB>, eLayerType, BoundingOrientedBox>;
+	using CandidatePredication = std::function<bool(const CandidateTuple&)>;
 	using RenderMap = concurrent_hash_map<eRenderComponentType, concurrent_vector<CandidateTuple, u_align_allocator<CandidateTuple>>>;
 
+	// Render state of the frame. Once it is built, render passes only read from the snapshot and do not
+	// touch the live transforms.
+	struct RenderSnapshot
+	{
+		RenderMap           candidates[SHADER_DOMAIN_MAX];
+		// Candidates in the camera frustum, shadow passes still need the others from the candidates.
+		RenderMap           visible[SHADER_DOMAIN_MAX];
+		std::atomic<UINT64> instance_count = 0;
+	};
+
+	// Candidates that pass the frustum culling are also added to the out_visible if it is given.
 	void BuildRenderMap(
-		const WeakScene& w_scene, RenderMap out_map[SHADER_DOMAIN_MAX], std::atomic<UINT64>& instance_count
+		const WeakScene&     w_scene, RenderMap out_map[SHADER_DOMAIN_MAX],
+		std::atomic<UINT64>& instance_count, RenderMap out_visible[SHADER_DOMAIN_MAX] = nullptr
 	);
 	void PremapModelImpl(
 		const WeakModelRenderer& model_component, RenderMap out_map[SHADER_DOMAIN_MAX],
-		std::atomic<UINT64>&     instance_count
+		std::atomic<UINT64>&     instance_count, RenderMap out_visible[SHADER_DOMAIN_MAX] = nullptr
 	);
 	void PremapParticleImpl(
 		const WeakParticleRenderer& particle_component, RenderMap out_map[SHADER_DOMAIN_MAX],
-		std::atomic<UINT64>&        instance_count
+		std::atomic<UINT64>&        instance_count, RenderMap out_visible[SHADER_DOMAIN_MAX] = nullptr
 	);
 }
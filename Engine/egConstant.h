@@ -30,13 +30,19 @@ namespace Engine
 	constexpr float   g_epsilon_squared                     = g_epsilon * g_epsilon;
 	constexpr float   g_gravity_acc                         = 9.81f;
 	constexpr float   g_fixed_update_interval               = 1.f / 32.f;
+	constexpr UINT    g_fixed_update_max_steps              = 4;
+	constexpr float   g_fixed_update_max_debt               = g_fixed_update_interval * 2.f;
 	constexpr Vector3 g_gravity_vec                         = Vector3(0.0f, -g_gravity_acc, 0.0f);
 	constexpr float   g_restitution_coefficient             = 0.66f;
 	constexpr float   g_drag_coefficient                    = 0.25f;
 	constexpr size_t  g_gjk_max_iteration                   = 64;
 	constexpr size_t  g_epa_max_iteration                   = 64;
+	constexpr size_t  g_gjk_hill_climb_threshold            = 32;
+	constexpr size_t  g_convex_hull_vertex_budget           = 256;
 	constexpr size_t  g_speculation_bisection_max_iteration = 64;
 	constexpr bool    g_speculation_enabled                 = true;
+	constexpr size_t  g_rigidbody_parallel_grain            = 64;
+	constexpr size_t  g_narrowphase_parallel_grain          = 16;
 #define PHYSX_ENABLED
 
 	// Misc
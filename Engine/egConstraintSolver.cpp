@@ -208,4 +208,15 @@ namespace Engine::Manager::Physics
 		// Change the future position to preventing the tunneling.
 		lrb->Synchronize();
 	}
+
+	ManagerAccess ConstraintSolver::GetAccess(const eManagerPhase phase) const
+	{
+		switch (phase)
+		{
+		case MANAGER_PHASE_FIXED_UPDATE:
+			return g_manager_access_exclusive;
+		default:
+			return g_manager_access_none;
+		}
+	}
 } // namespace Engine::Manager::Physics
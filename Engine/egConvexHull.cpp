@@ -0,0 +1,361 @@
+#include "pch.h"
+#include "egConvexHull.hpp"
+
+#undef min
+#undef max
+
+namespace Engine::Physics
+{
+	namespace
+	{
+		struct HullFace
+		{
+			UINT              v[3];
+			Vector3           normal;
+			float             offset;
+			std::vector<UINT> outside;
+			// Furthest point of the outside set.
+			UINT  eye;
+			float eye_distance;
+			bool  alive;
+
+			float Distance(const Vector3& point) const
+			{
+				return normal.Dot(point) - offset;
+			}
+		};
+
+		// Face oriented away from the interior point.
+		HullFace MakeFace(const std::vector<Vector3>& points, UINT a, UINT b, const UINT c, const Vector3& interior)
+		{
+			Vector3 normal = (points[b] - points[a]).Cross(points[c] - points[a]);
+
+			if (normal.Dot(interior - points[a]) > 0.f)
+			{
+				std::swap(a, b);
+				normal = -normal;
+			}
+
+			normal.Normalize();
+
+			return {{a, b, c}, normal, normal.Dot(points[a]), {}, 0, 0.f, true};
+		}
+
+		// Moves the point to the outside set of the face it is the furthest above, drops it if it is inside.
+		void AssignOutside(
+			std::vector<HullFace>& faces, const std::span<const size_t> candidates, const std::vector<Vector3>& points,
+			const UINT             point, const float                   epsilon
+		)
+		{
+			float  max  = epsilon;
+			size_t best = faces.size();
+
+			for (const size_t index : candidates)
+			{
+				const float distance = faces[index].Distance(points[point]);
+
+				if (distance > max)
+				{
+					max  = distance;
+					best = index;
+				}
+			}
+
+			if (best != faces.size())
+			{
+				faces[best].outside.push_back(point);
+
+				if (max > faces[best].eye_distance)
+				{
+					faces[best].eye          = point;
+					faces[best].eye_distance = max;
+				}
+			}
+		}
+	}
+
+	ConvexHull ConvexHull::Build(const std::span<const Vector3> points, const size_t budget)
+	{
+		ConvexHull hull;
+
+		// Render meshes repeat the position for each normal and uv.
+		std::vector<Vector3> welded(points.begin(), points.end());
+
+		std::ranges::sort
+				(
+				 welded, [](const Vector3& lhs, const Vector3& rhs)
+				 {
+					 return std::tie(lhs.x, lhs.y, lhs.z) < std::tie(rhs.x, rhs.y, rhs.z);
+				 }
+				);
+
+		const auto [first, last] = std::ranges::unique(welded);
+		welded.erase(first, last);
+
+		if (welded.size() < 4)
+		{
+			hull.vertices = std::move(welded);
+			return hull;
+		}
+
+		// Tolerance relative to the extent of the points.
+		Vector3 extent;
+		UINT    extremes[6] = {};
+
+		for (UINT i = 0; i < welded.size(); ++i)
+		{
+			const Vector3& p = welded[i];
+
+			extent.x = std::max(extent.x, std::fabsf(p.x));
+			extent.y = std::max(extent.y, std::fabsf(p.y));
+			extent.z = std::max(extent.z, std::fabsf(p.z));
+
+			for (int axis = 0; axis < 3; ++axis)
+			{
+				const float value = (&p.x)[axis];
+
+				if (value < (&welded[extremes[axis * 2]].x)[axis])
+				{
+					extremes[axis * 2] = i;
+				}
+				if (value > (&welded[extremes[axis * 2 + 1]].x)[axis])
+				{
+					extremes[axis * 2 + 1] = i;
+				}
+			}
+		}
+
+		const float epsilon = 3.f * FLT_EPSILON * (extent.x + extent.y + extent.z);
+
+		// Initial tetrahedron, the widest pair of the extremes, then the furthest from the line and the plane.
+		UINT  i0 = extremes[0];
+		UINT  i1 = extremes[1];
+		float max = 0.f;
+
+		for (int axis = 0; axis < 3; ++axis)
+		{
+			const float distance = Vector3::DistanceSquared(welded[extremes[axis * 2]], welded[extremes[axis * 2 + 1]]);
+
+			if (distance > max)
+			{
+				max = distance;
+				i0  = extremes[axis * 2];
+				i1  = extremes[axis * 2 + 1];
+			}
+		}
+
+		Vector3 line = welded[i1] - welded[i0];
+		line.Normalize();
+
+		UINT i2 = i0;
+		max     = 0.f;
+
+		for (UINT i = 0; i < welded.size(); ++i)
+		{
+			const float distance = (welded[i] - welded[i0]).Cross(line).LengthSquared();
+
+			if (distance > max)
+			{
+				max = distance;
+				i2  = i;
+			}
+		}
+
+		if (max <= epsilon * epsilon)
+		{
+			hull.vertices = std::move(welded);
+			return hull;
+		}
+
+		Vector3 plane = (welded[i1] - welded[i0]).Cross(welded[i2] - welded[i0]);
+		plane.Normalize();
+
+		UINT i3 = i0;
+		max     = 0.f;
+
+		for (UINT i = 0; i < welded.size(); ++i)
+		{
+			const float distance = std::fabsf(plane.Dot(welded[i] - welded[i0]));
+
+			if (distance > max)
+			{
+				max = distance;
+				i3  = i;
+			}
+		}
+
+		if (max <= epsilon)
+		{
+			hull.vertices = std::move(welded);
+			return hull;
+		}
+
+		const Vector3 interior = (welded[i0] + welded[i1] + welded[i2] + welded[i3]) * 0.25f;
+
+		std::vector<HullFace> faces;
+		faces.push_back(MakeFace(welded, i0, i1, i2, interior));
+		faces.push_back(MakeFace(welded, i0, i1, i3, interior));
+		faces.push_back(MakeFace(welded, i0, i2, i3, interior));
+		faces.push_back(MakeFace(welded, i1, i2, i3, interior));
+
+		{
+			constexpr size_t initial[] = {0, 1, 2, 3};
+
+			for (UINT i = 0; i < welded.size(); ++i)
+			{
+				if (i != i0 && i != i1 && i != i2 && i != i3)
+				{
+					AssignOutside(faces, initial, welded, i, epsilon);
+				}
+			}
+		}
+
+		std::set<std::pair<UINT, UINT>> visible_edges;
+		std::vector<size_t>             visible;
+		std::vector<size_t>             created;
+		std::vector<UINT>               orphans;
+
+		// Hull grows from the furthest point, the budget drops the points that change the hull the least.
+		size_t count = 4;
+
+		while (count < budget)
+		{
+			size_t current  = faces.size();
+			float  furthest = 0.f;
+
+			for (size_t i = 0; i < faces.size(); ++i)
+			{
+				if (faces[i].alive && !faces[i].outside.empty() && faces[i].eye_distance > furthest)
+				{
+					furthest = faces[i].eye_distance;
+					current  = i;
+				}
+			}
+
+			if (current == faces.size())
+			{
+				break;
+			}
+
+			const UINT eye = faces[current].eye;
+
+			visible.clear();
+			visible_edges.clear();
+			orphans.clear();
+
+			for (size_t i = 0; i < faces.size(); ++i)
+			{
+				if (faces[i].alive && faces[i].Distance(welded[eye]) > epsilon)
+				{
+					visible.push_back(i);
+
+					for (int e = 0; e < 3; ++e)
+					{
+						visible_edges.emplace(faces[i].v[e], faces[i].v[(e + 1) % 3]);
+					}
+				}
+			}
+
+			created.clear();
+
+			for (const size_t index : visible)
+			{
+				// Copied, the new faces may reallocate the faces.
+				const UINT v[3] = {faces[index].v[0], faces[index].v[1], faces[index].v[2]};
+
+				// Edge is on the horizon if the face on the other side is not visible.
+				for (int e = 0; e < 3; ++e)
+				{
+					const UINT a = v[e];
+					const UINT b = v[(e + 1) % 3];
+
+					if (!visible_edges.contains({b, a}))
+					{
+						created.push_back(faces.size());
+						faces.push_back(MakeFace(welded, a, b, eye, interior));
+					}
+				}
+
+				for (const UINT point : faces[index].outside)
+				{
+					if (point != eye)
+					{
+						orphans.push_back(point);
+					}
+				}
+
+				faces[index].alive = false;
+				faces[index].outside.clear();
+				faces[index].outside.shrink_to_fit();
+			}
+
+			for (const UINT point : orphans)
+			{
+				AssignOutside(faces, created, welded, point, epsilon);
+			}
+
+			++count;
+		}
+
+		// Compacts the vertices of the hull and links the vertices sharing an edge.
+		std::vector<UINT>           remap(welded.size(), std::numeric_limits<UINT>::max());
+		std::vector<std::set<UINT>> neighbours;
+
+		const auto index_of = [&](const UINT point)
+		{
+			if (remap[point] == std::numeric_limits<UINT>::max())
+			{
+				remap[point] = static_cast<UINT>(hull.vertices.size());
+				hull.vertices.push_back(welded[point]);
+				neighbours.emplace_back();
+			}
+
+			return remap[point];
+		};
+
+		for (const HullFace& face : faces)
+		{
+			if (!face.alive)
+			{
+				continue;
+			}
+
+			const UINT v[3] = {index_of(face.v[0]), index_of(face.v[1]), index_of(face.v[2])};
+
+			for (int e = 0; e < 3; ++e)
+			{
+				neighbours[v[e]].insert(v[(e + 1) % 3]);
+				neighbours[v[(e + 1) % 3]].insert(v[e]);
+			}
+		}
+
+		hull.adjacency_offsets.reserve(hull.vertices.size() + 1);
+		hull.adjacency_offsets.push_back(0);
+
+		for (const auto& set : neighbours)
+		{
+			hull.adjacency.insert(hull.adjacency.end(), set.begin(), set.end());
+			hull.adjacency_offsets.push_back(static_cast<UINT>(hull.adjacency.size()));
+		}
+
+		return hull;
+	}
+
+	ConvexHull ConvexHull::Build(const VertexCollection& vertices, const size_t budget)
+	{
+		std::vector<Vector3> points;
+		points.reserve(vertices.size());
+
+		for (const auto& vertex : vertices)
+		{
+			points.push_back(vertex.position);
+		}
+
+		return Build(points, budget);
+	}
+
+	bool ConvexHull::HasAdjacency() const
+	{
+		return !adjacency_offsets.empty();
+	}
+}
@@ -0,0 +1,33 @@
+#pragma once
+#include <span>
+#include <vector>
+
+namespace Engine::Physics
+{
+	// Convex hull of the point set built by the quickhull, with the vertex adjacency of the hull for the
+	// hill-climbing support mapping. Degenerate point sets keep the welded points without the adjacency.
+	struct ConvexHull
+	{
+		std::vector<Vector3> vertices;
+		// Neighbours of the vertex i are in [adjacency_offsets[i], adjacency_offsets[i + 1]) of the adjacency.
+		std::vector<UINT> adjacency_offsets;
+		std::vector<UINT> adjacency;
+
+		// Hull stops growing at the budget, the points left out are the closest ones to the hull.
+		static ConvexHull Build(std::span<const Vector3> points, size_t budget = g_convex_hull_vertex_budget);
+		static ConvexHull Build(const VertexCollection& vertices, size_t budget = g_convex_hull_vertex_budget);
+
+		bool HasAdjacency() const;
+
+	private:
+		friend class boost::serialization::access;
+
+		template <class Archive>
+		void serialize(Archive& ar, const unsigned int file_version)
+		{
+			ar & vertices;
+			ar & adjacency_offsets;
+			ar & adjacency;
+		}
+	};
+}
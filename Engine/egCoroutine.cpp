@@ -0,0 +1,233 @@
+#include "pch.h"
+#include "egCoroutine.h"
+
+#include "egManagerHelper.hpp"
+#include "egScript.h"
+
+namespace Engine
+{
+	Coroutine::Coroutine(Coroutine&& other) noexcept
+		: m_handle_(std::exchange(other.m_handle_, nullptr)) {}
+
+	Coroutine& Coroutine::operator=(Coroutine&& other) noexcept
+	{
+		if (this != &other)
+		{
+			if (m_handle_)
+			{
+				m_handle_.destroy();
+			}
+
+			m_handle_ = std::exchange(other.m_handle_, nullptr);
+		}
+
+		return *this;
+	}
+
+	Coroutine::~Coroutine()
+	{
+		if (m_handle_)
+		{
+			m_handle_.destroy();
+		}
+	}
+
+	bool Coroutine::Done() const
+	{
+		return !m_handle_ || m_handle_.done();
+	}
+
+	void CoroutineScheduler::Start(const WeakScript& owner, Coroutine&& coroutine)
+	{
+		if (coroutine.Done())
+		{
+			return;
+		}
+
+		Entry entry{owner, owner.lock().get(), std::move(coroutine)};
+
+		if (resume(entry))
+		{
+			schedule(std::move(entry));
+		}
+	}
+
+	void CoroutineScheduler::Update(const float dt)
+	{
+		m_time_ += dt;
+
+		// Routines that are scheduled while resuming are handled in the next update.
+		std::vector<Entry> due = std::move(m_next_frame_);
+		m_next_frame_.clear();
+
+		while (!m_timers_.empty() && m_timers_.front().wake_time <= m_time_)
+		{
+			std::ranges::pop_heap(m_timers_, &CoroutineScheduler::laterTimer);
+			due.push_back(std::move(m_timers_.back().entry));
+			m_timers_.pop_back();
+		}
+
+		std::vector<Entry> waiting;
+
+		for (auto& entry : m_conditions_)
+		{
+			if (entry.owner.expired())
+			{
+				continue;
+			}
+
+			if (entry.coroutine.m_handle_.promise().condition())
+			{
+				due.push_back(std::move(entry));
+			}
+			else
+			{
+				waiting.push_back(std::move(entry));
+			}
+		}
+
+		m_conditions_ = std::move(waiting);
+
+		m_b_updating_ = true;
+
+		for (auto& entry : due)
+		{
+			// Stopped by the other routine in this update.
+			if (std::ranges::find(m_stopped_, entry.key) != m_stopped_.end())
+			{
+				continue;
+			}
+
+			const auto script = entry.owner.lock();
+
+			// Script is destroyed, routine is destroyed with the entry.
+			if (!script)
+			{
+				continue;
+			}
+
+			// Routine is paused while the script is inactive, resume it at the first update after activation.
+			if (!script->GetActive())
+			{
+				entry.coroutine.m_handle_.promise().wait = COROUTINE_WAIT_NEXT_FRAME;
+				m_next_frame_.push_back(std::move(entry));
+				continue;
+			}
+
+			// Routine can stop itself while it is running.
+			if (resume(entry) && std::ranges::find(m_stopped_, entry.key) == m_stopped_.end())
+			{
+				schedule(std::move(entry));
+			}
+		}
+
+		m_b_updating_ = false;
+		m_stopped_.clear();
+	}
+
+	void CoroutineScheduler::Stop(const Script* owner)
+	{
+		const auto pred = [owner](const Entry& entry)
+		{
+			return entry.key == owner;
+		};
+
+		std::erase_if(m_next_frame_, pred);
+		std::erase_if(m_conditions_, pred);
+		std::erase_if
+				(
+				 m_timers_, [&pred](const Timer& timer)
+				 {
+					 return pred(timer.entry);
+				 }
+				);
+		std::ranges::make_heap(m_timers_, &CoroutineScheduler::laterTimer);
+
+		// Due routines are out of the containers, dropped after the resume loop.
+		if (m_b_updating_)
+		{
+			m_stopped_.push_back(owner);
+		}
+	}
+
+	void CoroutineScheduler::Clear()
+	{
+		m_next_frame_.clear();
+		m_timers_.clear();
+		m_conditions_.clear();
+	}
+
+	float CoroutineScheduler::GetTime() const
+	{
+		return m_time_;
+	}
+
+	bool CoroutineScheduler::resume(Entry& entry)
+	{
+		const auto& handle         = entry.coroutine.m_handle_;
+		handle.promise().wait      = COROUTINE_WAIT_NONE;
+		handle.promise().condition = nullptr;
+		handle.resume();
+
+		// Exception is contained in the routine, the other routines are resumed as usual.
+		if (handle.promise().exception)
+		{
+			try
+			{
+				std::rethrow_exception(handle.promise().exception);
+			}
+			catch (const std::exception& e)
+			{
+				GetDebugger().Log(std::format("Coroutine terminated by an exception: {}", e.what()));
+			}
+			catch (...)
+			{
+				GetDebugger().Log("Coroutine terminated by an unknown exception");
+			}
+
+			return false;
+		}
+
+		return !handle.done();
+	}
+
+	void CoroutineScheduler::schedule(Entry&& entry)
+	{
+		const auto& promise = entry.coroutine.m_handle_.promise();
+
+		switch (promise.wait)
+		{
+		case COROUTINE_WAIT_SECONDS:
+		{
+			// Wake time is relative at the suspension.
+			const float wake_time = m_time_ + promise.wake_time;
+			pushTimer(std::move(entry), wake_time);
+			break;
+		}
+		case COROUTINE_WAIT_CONDITION:
+			m_conditions_.push_back(std::move(entry));
+			break;
+		case COROUTINE_WAIT_NEXT_FRAME:
+		case COROUTINE_WAIT_NONE:
+		default:
+			m_next_frame_.push_back(std::move(entry));
+			break;
+		}
+	}
+
+	bool CoroutineScheduler::laterTimer(const Timer& lhs, const Timer& rhs)
+	{
+		if (lhs.wake_time != rhs.wake_time)
+		{
+			return lhs.wake_time > rhs.wake_time;
+		}
+
+		return lhs.sequence > rhs.sequence;
+	}
+
+	void CoroutineScheduler::pushTimer(Entry&& entry, const float wake_time)
+	{
+		m_timers_.push_back({wake_time, m_sequence_++, std::move(entry)});
+		std::ranges::push_heap(m_timers_, &CoroutineScheduler::laterTimer);
+	}
+}
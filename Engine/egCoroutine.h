@@ -0,0 +1,180 @@
+#pragma once
+#include <coroutine>
+#include <exception>
+#include <functional>
+#include <vector>
+
+namespace Engine
+{
+	// Script routine which suspends itself with co_await NextFrame(), WaitSeconds(t) or WaitUntil(pred).
+	// Routine is owned by the coroutine scheduler of the scene, and resumed only when it is due.
+	class Coroutine
+	{
+	public:
+		struct promise_type
+		{
+			eCoroutineWait        wait      = COROUTINE_WAIT_NONE;
+			float                 wake_time = 0.f;
+			std::function<bool()> condition;
+			// Exception of the routine, reported by the scheduler.
+			std::exception_ptr exception;
+
+			Coroutine get_return_object()
+			{
+				return Coroutine{std::coroutine_handle<promise_type>::from_promise(*this)};
+			}
+
+			// Scheduler starts the routine.
+			std::suspend_always initial_suspend() noexcept
+			{
+				return {};
+			}
+
+			std::suspend_always final_suspend() noexcept
+			{
+				return {};
+			}
+
+			void return_void() {}
+
+			void unhandled_exception()
+			{
+				exception = std::current_exception();
+			}
+		};
+
+		using handle_type = std::coroutine_handle<promise_type>;
+
+		Coroutine() = default;
+		Coroutine(Coroutine&& other) noexcept;
+		Coroutine& operator=(Coroutine&& other) noexcept;
+		Coroutine(const Coroutine&)            = delete;
+		Coroutine& operator=(const Coroutine&) = delete;
+		~Coroutine();
+
+		bool Done() const;
+
+	private:
+		friend class CoroutineScheduler;
+
+		explicit Coroutine(handle_type handle)
+			: m_handle_(handle) {}
+
+		handle_type m_handle_;
+	};
+
+	// Suspend until the next update.
+	struct NextFrame
+	{
+		bool await_ready() const noexcept
+		{
+			return false;
+		}
+
+		void await_suspend(const Coroutine::handle_type handle) const noexcept
+		{
+			handle.promise().wait = COROUTINE_WAIT_NEXT_FRAME;
+		}
+
+		void await_resume() const noexcept {}
+	};
+
+	// Suspend until the given seconds are elapsed in the scene time. (Paused time is not counted)
+	struct WaitSeconds
+	{
+		explicit WaitSeconds(const float seconds)
+			: seconds(seconds) {}
+
+		bool await_ready() const noexcept
+		{
+			return seconds <= 0.f;
+		}
+
+		void await_suspend(const Coroutine::handle_type handle) const noexcept
+		{
+			handle.promise().wait      = COROUTINE_WAIT_SECONDS;
+			handle.promise().wake_time = seconds;
+		}
+
+		void await_resume() const noexcept {}
+
+		float seconds;
+	};
+
+	// Suspend until the predicate is satisfied. Predicate is checked once per update.
+	struct WaitUntil
+	{
+		explicit WaitUntil(std::function<bool()> predicate)
+			: predicate(std::move(predicate)) {}
+
+		bool await_ready() const
+		{
+			return predicate();
+		}
+
+		void await_suspend(const Coroutine::handle_type handle)
+		{
+			handle.promise().wait      = COROUTINE_WAIT_CONDITION;
+			handle.promise().condition = std::move(predicate);
+		}
+
+		void await_resume() const noexcept {}
+
+		std::function<bool()> predicate;
+	};
+
+	class CoroutineScheduler
+	{
+	public:
+		CoroutineScheduler()
+			: m_time_(0.f),
+			  m_sequence_(0),
+			  m_b_updating_(false) {}
+
+		// Run the routine until the first suspension, and schedule it if it is not finished.
+		void Start(const WeakScript& owner, Coroutine&& coroutine);
+		// Advance the time and resume the due routines.
+		void Update(float dt);
+		// Drop every routine of the script. Routines of the script which are being resumed are dropped after
+		// the resume.
+		void Stop(const Script* owner);
+		void Clear();
+
+		// Accumulated time of the updates.
+		float GetTime() const;
+
+	private:
+		struct Entry
+		{
+			WeakScript    owner;
+			const Script* key;
+			Coroutine     coroutine;
+		};
+
+		struct Timer
+		{
+			float  wake_time;
+			UINT64 sequence;
+			Entry  entry;
+		};
+
+		// Returns true if the routine is suspended again.
+		bool resume(Entry& entry);
+		void schedule(Entry&& entry);
+		void pushTimer(Entry&& entry, float wake_time);
+
+		static bool laterTimer(const Timer& lhs, const Timer& rhs);
+
+		float  m_time_;
+		UINT64 m_sequence_;
+
+		// Scripts stopped while the due routines are resumed.
+		bool                       m_b_updating_;
+		std::vector<const Script*> m_stopped_;
+
+		std::vector<Entry> m_next_frame_;
+		// Min-heap by the wake time, ties are resolved by the order of the scheduling.
+		std::vector<Timer> m_timers_;
+		std::vector<Entry> m_conditions_;
+	};
+}
@@ -898,4 +898,15 @@ namespace Engine::Manager::Graphics
 
 		return m_fence_nonce_[buffer_idx];
 	}
+
+	ManagerAccess D3Device::GetAccess(const eManagerPhase phase) const
+	{
+		switch (phase)
+		{
+		case MANAGER_PHASE_SUBMIT:
+			return g_manager_access_exclusive;
+		default:
+			return g_manager_access_none;
+		}
+	}
 } // namespace Engine::Manager::Graphics
@@ -36,6 +36,7 @@ namespace Engine::Manager::Graphics
 			: Singleton() {}
 
 		void            Initialize(HWND hWnd) override;
+		ManagerAccess   GetAccess(eManagerPhase phase) const override;
 		ID3D12Resource* GetRenderTarget(UINT64 frame_idx);
 
 		static void DEBUG_DEVICE_REMOVED(ID3D12Device* device)
@@ -3,6 +3,7 @@
 
 #include <DescriptorHeap.h>
 
+#include "egBenchmark.hpp"
 #include "egCamera.h"
 #include "egGlobal.h"
 #include "egSceneManager.hpp"
@@ -74,6 +75,12 @@ namespace Engine::Manager
 			return;
 		}
 
+		{
+			std::lock_guard l(m_pending_lock_);
+			std::move(m_pending_queue_.begin(), m_pending_queue_.end(), std::back_inserter(m_render_queue));
+			m_pending_queue_.clear();
+		}
+
 		if (m_render_queue.empty())
 		{
 			return;
@@ -162,6 +169,52 @@ namespace Engine::Manager
 
 				ImGui::DragFloat("Camera speed", &g_camera_speed, 0.1f, 0.f, 1.f);
 
+				const auto fixed_step = GetApplication().GetFixedStep().GetStatistics();
+				ImGui::Text("Fixed steps: %u", fixed_step.steps);
+				ImGui::Text("Dropped time: %.4fs (total %.4fs)", fixed_step.dropped, fixed_step.total_dropped);
+				ImGui::Text("Clamped frames: %llu", fixed_step.clamped_frames);
+
+				if (ImGui::CollapsingHeader("Benchmark"))
+				{
+					if (ImGui::Button("Task submission"))
+					{
+						const auto result = Benchmark::TaskSubmission();
+						Log(std::format("Task submission: TaskValue {:.3f}ms, typed {:.3f}ms", result.baseline_ms, result.current_ms));
+					}
+
+					if (ImGui::Button("Rigidbody integration"))
+					{
+						const auto result = Benchmark::RigidbodyIntegration();
+						Log
+								(
+								 std::format
+								 (
+								  "Rigidbody integration: serial {:.3f}ms, parallel {:.3f}ms, {} mismatches",
+								  result.baseline_ms, result.current_ms, result.mismatches
+								 )
+								);
+					}
+
+					if (ImGui::Button("Singleton access"))
+					{
+						const auto result = Benchmark::SingletonAccess();
+						Log(std::format("Singleton access: locked {:.3f}ms, published {:.3f}ms", result.baseline_ms, result.current_ms));
+					}
+
+					if (ImGui::Button("Octree nearest"))
+					{
+						const auto result = Benchmark::OctreeNearest();
+						Log
+								(
+								 std::format
+								 (
+								  "Octree nearest: linear {:.3f}ms, octree {:.3f}ms, {} mismatches",
+								  result.baseline_ms, result.current_ms, result.mismatches
+								 )
+								);
+					}
+				}
+
 				ImGui::End();
 			}
 		}
@@ -311,11 +364,26 @@ namespace Engine::Manager
 			return;
 		}
 
-		if (m_render_queue.size() > g_debug_message_max)
+		std::lock_guard l(m_pending_lock_);
+
+		if (m_pending_queue_.size() > g_debug_message_max)
 		{
-			m_render_queue.pop_front();
+			m_pending_queue_.pop_front();
 		}
 
-		m_render_queue.emplace_back(msg, func);
+		m_pending_queue_.emplace_back(msg, func);
+	}
+
+	ManagerAccess Debugger::GetAccess(const eManagerPhase phase) const
+	{
+		switch (phase)
+		{
+		case MANAGER_PHASE_UPDATE:
+			return {MANAGER_ACCESS_INPUT | MANAGER_ACCESS_SCENE, MANAGER_ACCESS_TRANSFORM};
+		case MANAGER_PHASE_SUBMIT:
+			return g_manager_access_exclusive;
+		default:
+			return g_manager_access_none;
+		}
 	}
 } // namespace Engine::Manager
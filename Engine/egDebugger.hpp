@@ -1,6 +1,7 @@
 #pragma once
 #include <Windows.h>
 #include <memory>
+#include <mutex>
 #include <queue>
 
 #include <SpriteFont.h>
@@ -18,6 +19,7 @@ namespace Engine::Manager
 	public:
 		explicit Debugger(SINGLETON_LOCK_TOKEN);
 		void     Initialize() override;
+		ManagerAccess GetAccess(eManagerPhase phase) const override;
 
 		void Log(const std::string& str);
 		void Draw(const Vector3& start, const Vector3& end, const XMVECTORF32& color);
@@ -64,6 +66,10 @@ namespace Engine::Manager
 		std::unique_ptr<SpriteFont> m_font_;
 
 		std::deque<DebugPair> m_render_queue;
+		// Messages pushed from the other threads or while the render queue is being submitted.
+		// Moved to the render queue at the start of the post render.
+		std::mutex            m_pending_lock_;
+		std::deque<DebugPair> m_pending_queue_;
 	};
 } // namespace Engine::Manager
 
@@ -0,0 +1,691 @@
+#include "pch.h"
+#include "egDynamicAABBTree.hpp"
+
+#include "egDebugger.hpp"
+
+namespace Engine
+{
+	DynamicAABBTree::DynamicAABBTree()
+		: m_root_(invalid_node) {}
+
+	eSpatialIndexType DynamicAABBTree::GetType() const
+	{
+		return SPATIAL_INDEX_AABB_TREE;
+	}
+
+	size_t DynamicAABBTree::GetCount() const
+	{
+		return m_lookup_.size();
+	}
+
+	int DynamicAABBTree::GetHeight() const
+	{
+		return m_root_ == invalid_node ? 0 : m_nodes_[m_root_].height;
+	}
+
+	bool DynamicAABBTree::Insert(const WeakT& obj)
+	{
+		const auto locked = obj.lock();
+
+		if (!locked)
+		{
+			return false;
+		}
+
+		const Physics::GenericBounding bounding = bounding_getter::value(*locked);
+		const BoundingBox              aabb     = bounding.GetAABB();
+
+		// Already in the tree, refresh the bounds.
+		if (const auto it = m_lookup_.find(locked->GetID()); it != m_lookup_.end())
+		{
+			Node& node    = m_nodes_[it->second];
+			node.aabb     = aabb;
+			node.bounding = bounding;
+
+			if (node.bounds.Contains(aabb) != DirectX::ContainmentType::CONTAINS)
+			{
+				removeLeaf(it->second);
+				m_nodes_[it->second].bounds = Fatten(aabb);
+				insertLeaf(it->second);
+			}
+
+			sense(locked->GetID(), obj, aabb);
+
+			return true;
+		}
+
+		const NodeIndex index = allocateNode();
+		Node&           node  = m_nodes_[index];
+
+		node.bounds   = Fatten(aabb);
+		node.aabb     = aabb;
+		node.bounding = bounding;
+		node.height   = 0;
+		node.id     = locked->GetID();
+		node.object = obj;
+
+		m_lookup_[node.id] = index;
+		insertLeaf(index);
+		sense(locked->GetID(), obj, aabb);
+
+		return true;
+	}
+
+	void DynamicAABBTree::Remove(const WeakT& obj)
+	{
+		const auto locked = obj.lock();
+
+		if (!locked)
+		{
+			return;
+		}
+
+		if (const auto it = m_lookup_.find(locked->GetID()); it != m_lookup_.end())
+		{
+			const NodeIndex index = it->second;
+			m_lookup_.erase(it);
+			unsense(locked->GetID());
+
+			removeLeaf(index);
+			freeNode(index);
+		}
+	}
+
+	void DynamicAABBTree::Update()
+	{
+		StrongObjectBase obj;
+
+		clearSensorEvents();
+
+		while (popMoved(obj))
+		{
+			const auto it = m_lookup_.find(obj->GetID());
+
+			if (it == m_lookup_.end())
+			{
+				continue;
+			}
+
+			Node& node    = m_nodes_[it->second];
+			node.bounding = bounding_getter::value(*obj);
+			node.aabb     = node.bounding.GetAABB();
+			sense(node.id, node.object, node.aabb);
+
+			// Still in the fat bounds, the tree does not need to be touched.
+			if (node.bounds.Contains(node.aabb) == DirectX::ContainmentType::CONTAINS)
+			{
+				continue;
+			}
+
+			removeLeaf(it->second);
+			m_nodes_[it->second].bounds = Fatten(m_nodes_[it->second].aabb);
+			insertLeaf(it->second);
+		}
+
+		if constexpr (g_debug)
+		{
+			for (const NodeIndex index : m_lookup_ | std::views::values)
+			{
+				GetDebugger().Draw(m_nodes_[index].bounds, DirectX::Colors::BlanchedAlmond);
+			}
+		}
+	}
+
+	void DynamicAABBTree::Clear()
+	{
+		m_root_ = invalid_node;
+		m_nodes_.clear();
+		m_free_nodes_.clear();
+		m_lookup_.clear();
+
+		// Pending notifications are of the objects that are no longer in the tree.
+		clearMoved();
+		leaveSensors();
+	}
+
+	void DynamicAABBTree::ForEach(const ObjectFunc& func) const
+	{
+		for (const NodeIndex index : m_lookup_ | std::views::values)
+		{
+			func(m_nodes_[index].object);
+		}
+	}
+
+	void DynamicAABBTree::ForEachBounds(const BoundsFunc& func) const
+	{
+		for (const NodeIndex index : m_lookup_ | std::views::values)
+		{
+			func(m_nodes_[index].id, m_nodes_[index].object, m_nodes_[index].aabb);
+		}
+	}
+
+	void DynamicAABBTree::QueryPairs(const PairFunc& func) const
+	{
+		for (const NodeIndex lhs : m_lookup_ | std::views::values)
+		{
+			Query
+					(
+					 m_nodes_[lhs].bounds, [this, &func, lhs](const NodeIndex rhs)
+					 {
+						 // Leaf with the smaller index owns the pair.
+						 if (rhs <= lhs)
+						 {
+							 return;
+						 }
+
+						 func(m_nodes_[lhs].id, m_nodes_[rhs].id);
+					 }
+					);
+		}
+	}
+
+	void DynamicAABBTree::QueryRegion(const BoundingFrustum& region, const ObjectFunc& func) const
+	{
+		queryRegion(region, func);
+	}
+
+	void DynamicAABBTree::QueryRegion(const BoundingOrientedBox& region, const ObjectFunc& func) const
+	{
+		queryRegion(region, func);
+	}
+
+	void DynamicAABBTree::QueryRegion(const BoundingSphere& region, const ObjectFunc& func) const
+	{
+		queryRegion(region, func);
+	}
+
+	void DynamicAABBTree::Iterate(const Vector3& point, const std::function<bool(const WeakT&)>& func) const
+	{
+		if (m_root_ == invalid_node)
+		{
+			return;
+		}
+
+		using candidate = std::pair<float, NodeIndex>;
+
+		std::priority_queue<candidate, frame_vector<candidate>, std::greater<candidate>> queue;
+		queue.emplace(DistanceSquared(m_nodes_[m_root_].bounds, point), m_root_);
+
+		while (!queue.empty())
+		{
+			const NodeIndex index = queue.top().second;
+			queue.pop();
+
+			const Node& node = m_nodes_[index];
+
+			if (leaf(index))
+			{
+				if (func(node.object))
+				{
+					return;
+				}
+
+				continue;
+			}
+
+			queue.emplace(DistanceSquared(m_nodes_[node.left].bounds, point), node.left);
+			queue.emplace(DistanceSquared(m_nodes_[node.right].bounds, point), node.right);
+		}
+	}
+
+	std::vector<DynamicAABBTree::WeakT> DynamicAABBTree::Nearest(const Vector3& point, const float distance) const
+	{
+		std::vector<WeakT>   result;
+		const BoundingSphere search_sphere(point, distance);
+
+		Query
+				(
+				 search_sphere, [this, &search_sphere, &result](const NodeIndex index)
+				 {
+					 if (!m_nodes_[index].aabb.Intersects(search_sphere))
+					 {
+						 return;
+					 }
+
+					 if (const auto& bounding = m_nodes_[index].bounding;
+						 bounding.Intersects(search_sphere) || bounding.ContainsBy(search_sphere))
+					 {
+						 result.push_back(m_nodes_[index].object);
+					 }
+				 }
+				);
+
+		return result;
+	}
+
+	frame_vector<DynamicAABBTree::WeakT> DynamicAABBTree::KNearest(
+		const Vector3& point, const size_t k, const float distance
+	) const
+	{
+		frame_vector<WeakT> result;
+
+		if (m_root_ == invalid_node || k == 0)
+		{
+			return result;
+		}
+
+		using candidate = std::pair<float, NodeIndex>;
+
+		// Nodes from the nearest fat bounds, and the k nearest leaves so far with the farthest on the top.
+		std::priority_queue<candidate, frame_vector<candidate>, std::greater<candidate>> queue;
+		frame_vector<candidate>                                                          heap;
+		heap.reserve(k);
+
+		const float max_distance = FloatCompare(distance, 0.f)
+			                           ? std::numeric_limits<float>::max()
+			                           : distance * distance;
+
+		const auto bound = [&heap, &max_distance, k]()
+		{
+			return heap.size() == k ? heap.front().first : max_distance;
+		};
+
+		queue.emplace(DistanceSquared(m_nodes_[m_root_].bounds, point), m_root_);
+
+		while (!queue.empty())
+		{
+			const auto [node_distance, index] = queue.top();
+			queue.pop();
+
+			// Remaining nodes are farther than the farthest kept leaf.
+			if (node_distance > bound())
+			{
+				break;
+			}
+
+			const Node& node = m_nodes_[index];
+
+			if (!leaf(index))
+			{
+				queue.emplace(DistanceSquared(m_nodes_[node.left].bounds, point), node.left);
+				queue.emplace(DistanceSquared(m_nodes_[node.right].bounds, point), node.right);
+				continue;
+			}
+
+			const float leaf_distance = DistanceSquared(node.aabb, point);
+
+			if (leaf_distance > bound())
+			{
+				continue;
+			}
+
+			if (heap.size() == k)
+			{
+				std::ranges::pop_heap(heap);
+				heap.pop_back();
+			}
+
+			heap.emplace_back(leaf_distance, index);
+			std::ranges::push_heap(heap);
+		}
+
+		std::ranges::sort_heap(heap);
+		result.reserve(heap.size());
+
+		for (const NodeIndex index : heap | std::views::values)
+		{
+			result.push_back(m_nodes_[index].object);
+		}
+
+		return result;
+	}
+
+	std::vector<DynamicAABBTree::WeakT> DynamicAABBTree::Hitscan(
+		const Vector3& point, const Vector3& direction, const size_t count, const float distance
+	) const
+	{
+		std::vector<WeakT> result;
+
+		if (m_root_ == invalid_node)
+		{
+			return result;
+		}
+
+		frame_stack<NodeIndex> stack;
+		float                  dist = 0.f;
+
+		stack.push(m_root_);
+
+		while (!stack.empty())
+		{
+			const NodeIndex index = stack.top();
+			stack.pop();
+
+			const Node& node   = m_nodes_[index];
+			const auto& bounds = leaf(index) ? node.aabb : node.bounds;
+
+			if (!bounds.Intersects(point, direction, dist))
+			{
+				continue;
+			}
+
+			if (!FloatCompare(distance, 0.f) && dist > distance)
+			{
+				continue;
+			}
+
+			if (!leaf(index))
+			{
+				stack.push(node.left);
+				stack.push(node.right);
+				continue;
+			}
+
+			// Distance is taken from the bounding, the AABB hits earlier than the object.
+			if (!node.bounding.TestRay(point, direction, dist))
+			{
+				continue;
+			}
+
+			if (!FloatCompare(distance, 0.f) && dist > distance)
+			{
+				continue;
+			}
+
+			result.push_back(node.object);
+
+			if (count != 0 && result.size() == count)
+			{
+				break;
+			}
+		}
+
+		return result;
+	}
+
+	void DynamicAABBTree::hitscanPacket(const RayPacket& packet, PacketHits& hits) const
+	{
+		if (m_root_ == invalid_node)
+		{
+			return;
+		}
+
+		// Lanes that missed the node are dropped for the subtree.
+		frame_stack<std::pair<NodeIndex, int>> stack;
+		__m128                                 dist;
+
+		stack.emplace(m_root_, packet.lane_mask);
+
+		while (!stack.empty())
+		{
+			const auto [index, mask] = stack.top();
+			stack.pop();
+
+			const Node& node   = m_nodes_[index];
+			const auto& bounds = leaf(index) ? node.aabb : node.bounds;
+			const int   hit    = IntersectPacket(bounds, packet, mask, dist);
+
+			if (hit == 0)
+			{
+				continue;
+			}
+
+			if (!leaf(index))
+			{
+				stack.emplace(node.left, hit);
+				stack.emplace(node.right, hit);
+				continue;
+			}
+
+			AppendHits(hit, dist, node.object, hits);
+		}
+	}
+
+	DynamicAABBTree::NodeIndex DynamicAABBTree::allocateNode()
+	{
+		if (!m_free_nodes_.empty())
+		{
+			const NodeIndex index = m_free_nodes_.back();
+			m_free_nodes_.pop_back();
+			return index;
+		}
+
+		m_nodes_.emplace_back();
+		return static_cast<NodeIndex>(m_nodes_.size() - 1);
+	}
+
+	void DynamicAABBTree::freeNode(const NodeIndex index)
+	{
+		m_nodes_[index] = {};
+		m_free_nodes_.push_back(index);
+	}
+
+	void DynamicAABBTree::insertLeaf(const NodeIndex leaf_index)
+	{
+		if (m_root_ == invalid_node)
+		{
+			m_root_                     = leaf_index;
+			m_nodes_[leaf_index].parent = invalid_node;
+			return;
+		}
+
+		// Find the best sibling by the surface area heuristic.
+		const BoundingBox leaf_bounds = m_nodes_[leaf_index].bounds;
+		NodeIndex         index       = m_root_;
+
+		while (!leaf(index))
+		{
+			const Node& node = m_nodes_[index];
+
+			const float area          = SurfaceArea(node.bounds);
+			const float combined_area = SurfaceArea(Merge(node.bounds, leaf_bounds));
+
+			// Cost of creating a new parent for this node and the leaf.
+			const float cost = 2.f * combined_area;
+			// Minimum cost of pushing the leaf further down the tree.
+			const float inheritance = 2.f * (combined_area - area);
+
+			const auto descend_cost = [this, &leaf_bounds, inheritance](const NodeIndex child)
+			{
+				const float merged = SurfaceArea(Merge(leaf_bounds, m_nodes_[child].bounds));
+				return leaf(child) ? merged + inheritance : merged - SurfaceArea(m_nodes_[child].bounds) + inheritance;
+			};
+
+			const float cost_left  = descend_cost(node.left);
+			const float cost_right = descend_cost(node.right);
+
+			if (cost < cost_left && cost < cost_right)
+			{
+				break;
+			}
+
+			index = cost_left < cost_right ? node.left : node.right;
+		}
+
+		const NodeIndex sibling    = index;
+		const NodeIndex old_parent = m_nodes_[sibling].parent;
+		const NodeIndex new_parent = allocateNode();
+
+		Node& parent_node  = m_nodes_[new_parent];
+		parent_node.parent = old_parent;
+		parent_node.bounds = Merge(leaf_bounds, m_nodes_[sibling].bounds);
+		parent_node.height = m_nodes_[sibling].height + 1;
+		parent_node.left   = sibling;
+		parent_node.right  = leaf_index;
+
+		if (old_parent != invalid_node)
+		{
+			if (m_nodes_[old_parent].left == sibling)
+			{
+				m_nodes_[old_parent].left = new_parent;
+			}
+			else
+			{
+				m_nodes_[old_parent].right = new_parent;
+			}
+		}
+		else
+		{
+			m_root_ = new_parent;
+		}
+
+		m_nodes_[sibling].parent    = new_parent;
+		m_nodes_[leaf_index].parent = new_parent;
+
+		refit(new_parent);
+	}
+
+	void DynamicAABBTree::removeLeaf(const NodeIndex leaf_index)
+	{
+		if (leaf_index == m_root_)
+		{
+			m_root_ = invalid_node;
+			return;
+		}
+
+		const NodeIndex parent      = m_nodes_[leaf_index].parent;
+		const NodeIndex grandparent = m_nodes_[parent].parent;
+		const NodeIndex sibling     = m_nodes_[parent].left == leaf_index
+			                              ? m_nodes_[parent].right
+			                              : m_nodes_[parent].left;
+
+		m_nodes_[leaf_index].parent = invalid_node;
+
+		// Sibling takes the place of the parent.
+		if (grandparent != invalid_node)
+		{
+			if (m_nodes_[grandparent].left == parent)
+			{
+				m_nodes_[grandparent].left = sibling;
+			}
+			else
+			{
+				m_nodes_[grandparent].right = sibling;
+			}
+
+			m_nodes_[sibling].parent = grandparent;
+			freeNode(parent);
+			refit(grandparent);
+		}
+		else
+		{
+			m_root_                  = sibling;
+			m_nodes_[sibling].parent = invalid_node;
+			freeNode(parent);
+		}
+	}
+
+	void DynamicAABBTree::refit(NodeIndex index)
+	{
+		while (index != invalid_node)
+		{
+			index = balance(index);
+
+			Node&       node  = m_nodes_[index];
+			const Node& left  = m_nodes_[node.left];
+			const Node& right = m_nodes_[node.right];
+
+			node.height = 1 + std::max(left.height, right.height);
+			node.bounds = Merge(left.bounds, right.bounds);
+
+			index = node.parent;
+		}
+	}
+
+	DynamicAABBTree::NodeIndex DynamicAABBTree::balance(const NodeIndex index_a)
+	{
+		Node& a = m_nodes_[index_a];
+
+		if (leaf(index_a) || a.height < 2)
+		{
+			return index_a;
+		}
+
+		const NodeIndex index_b = a.left;
+		const NodeIndex index_c = a.right;
+		Node&           b       = m_nodes_[index_b];
+		Node&           c       = m_nodes_[index_c];
+
+		const int balance = c.height - b.height;
+
+		// Rotates the given child up, the child takes the place of a.
+		const auto rotate = [this, index_a, &a](const NodeIndex index_up, Node& up, Node& other, const bool up_is_right)
+		{
+			const NodeIndex index_f = up.left;
+			const NodeIndex index_g = up.right;
+			Node&           f       = m_nodes_[index_f];
+			Node&           g       = m_nodes_[index_g];
+
+			up.left   = index_a;
+			up.parent = a.parent;
+			a.parent  = index_up;
+
+			if (up.parent != invalid_node)
+			{
+				if (m_nodes_[up.parent].left == index_a)
+				{
+					m_nodes_[up.parent].left = index_up;
+				}
+				else
+				{
+					m_nodes_[up.parent].right = index_up;
+				}
+			}
+			else
+			{
+				m_root_ = index_up;
+			}
+
+			// Taller grandchild stays under the rotated node, the other one moves to a.
+			const bool      f_taller   = f.height > g.height;
+			const NodeIndex index_keep = f_taller ? index_f : index_g;
+			const NodeIndex index_move = f_taller ? index_g : index_f;
+			Node&           keep       = m_nodes_[index_keep];
+			Node&           move       = m_nodes_[index_move];
+
+			up.right    = index_keep;
+			move.parent = index_a;
+
+			if (up_is_right)
+			{
+				a.right = index_move;
+			}
+			else
+			{
+				a.left = index_move;
+			}
+
+			a.bounds  = Merge(other.bounds, move.bounds);
+			up.bounds = Merge(a.bounds, keep.bounds);
+			a.height  = 1 + std::max(other.height, move.height);
+			up.height = 1 + std::max(a.height, keep.height);
+		};
+
+		if (balance > 1)
+		{
+			rotate(index_c, c, b, true);
+			return index_c;
+		}
+
+		if (balance < -1)
+		{
+			rotate(index_b, b, c, false);
+			return index_b;
+		}
+
+		return index_a;
+	}
+
+	bool DynamicAABBTree::leaf(const NodeIndex index) const
+	{
+		return m_nodes_[index].left == invalid_node;
+	}
+
+	BoundingBox __vectorcall DynamicAABBTree::Fatten(const BoundingBox& bounds)
+	{
+		return BoundingBox(bounds.Center, Vector3(bounds.Extents) + Vector3(fat_margin));
+	}
+
+	BoundingBox __vectorcall DynamicAABBTree::Merge(const BoundingBox& lhs, const BoundingBox& rhs)
+	{
+		BoundingBox merged;
+		BoundingBox::CreateMerged(merged, lhs, rhs);
+		return merged;
+	}
+
+	float __vectorcall DynamicAABBTree::SurfaceArea(const BoundingBox& bounds)
+	{
+		const Vector3 size = Vector3(bounds.Extents) * 2.f;
+		return 2.f * (size.x * size.y + size.y * size.z + size.z * size.x);
+	}
+}
@@ -0,0 +1,170 @@
+#pragma once
+#include <unordered_map>
+#include <vector>
+#include "egFrameArena.hpp"
+#include "egSpatialIndex.hpp"
+
+namespace Engine
+{
+	// Bounding volume hierarchy of the fat AABBs, kept balanced by the rotations. The leaf is re-inserted only
+	// if the object moves out of its fat bounds. Unlike the octree, there is no map bound.
+	class DynamicAABBTree final : public SpatialIndex
+	{
+	public:
+		using NodeIndex = UINT;
+
+		constexpr static NodeIndex invalid_node = std::numeric_limits<NodeIndex>::max();
+
+		struct Node
+		{
+			// Fat bounds for the leaf, union of the children for the branch.
+			BoundingBox bounds = {};
+			NodeIndex   parent = invalid_node;
+			NodeIndex   left   = invalid_node;
+			NodeIndex   right  = invalid_node;
+			// Leaf is 0, free node is -1.
+			int height = -1;
+
+			// Leaf only, the tight bounds, the bounding that the queries confirm the hits with and the handle of
+			// the object.
+			BoundingBox              aabb = {};
+			Physics::GenericBounding bounding;
+			GlobalEntityID           id = g_invalid_id;
+			WeakT                    object;
+		};
+
+	private:
+		// Margin of the fat bounds, object can move this much without re-inserting.
+		constexpr static float fat_margin = 0.1f;
+
+	public:
+		DynamicAABBTree();
+
+		eSpatialIndexType GetType() const override;
+		size_t            GetCount() const override;
+		// Height of the root, balanced tree keeps it around log2 of the count.
+		int GetHeight() const;
+
+		bool Insert(const WeakT& obj) override;
+		void Remove(const WeakT& obj) override;
+		void Update() override;
+		void Clear() override;
+
+		void ForEach(const ObjectFunc& func) const override;
+		void ForEachBounds(const BoundsFunc& func) const override;
+		// Objects which the fat bounds overlap.
+		void QueryPairs(const PairFunc& func) const override;
+
+		void QueryRegion(const BoundingFrustum& region, const ObjectFunc& func) const override;
+		void QueryRegion(const BoundingOrientedBox& region, const ObjectFunc& func) const override;
+		void QueryRegion(const BoundingSphere& region, const ObjectFunc& func) const override;
+
+		// Visits the objects from the nearest bounds to the point.
+		void Iterate(const Vector3& point, const std::function<bool(const WeakT&)>& func) const override;
+		std::vector<WeakT>  Nearest(const Vector3& point, float distance) const override;
+		frame_vector<WeakT> KNearest(const Vector3& point, size_t k, float distance = 0.f) const override;
+		std::vector<WeakT> Hitscan(
+			const Vector3& point, const Vector3& direction, size_t count = 0, float distance = 0.f
+		) const override;
+
+		// Visits the leaves which the fat bounds intersect with the given bounds.
+		template <typename T, typename Func>
+		void Query(const T& bounds, Func&& func) const
+		{
+			if (m_root_ == invalid_node)
+			{
+				return;
+			}
+
+			frame_stack<NodeIndex> stack;
+			stack.push(m_root_);
+
+			while (!stack.empty())
+			{
+				const NodeIndex index = stack.top();
+				stack.pop();
+
+				const Node& node = m_nodes_[index];
+
+				if (!node.bounds.Intersects(bounds))
+				{
+					continue;
+				}
+
+				if (leaf(index))
+				{
+					func(index);
+					continue;
+				}
+
+				stack.push(node.left);
+				stack.push(node.right);
+			}
+		}
+
+	private:
+		void hitscanPacket(const RayPacket& packet, PacketHits& hits) const override;
+
+		template <typename T>
+		void queryRegion(const T& region, const ObjectFunc& func) const
+		{
+			if (m_root_ == invalid_node)
+			{
+				return;
+			}
+
+			// Node and whether its bounds is inside the region, then the leaves under it are taken as is.
+			frame_stack<std::pair<NodeIndex, bool>> stack;
+			stack.emplace(m_root_, false);
+
+			while (!stack.empty())
+			{
+				auto [index, inside] = stack.top();
+				stack.pop();
+
+				const Node& node = m_nodes_[index];
+
+				if (!inside)
+				{
+					const auto containment = region.Contains(leaf(index) ? node.aabb : node.bounds);
+
+					if (containment == DirectX::DISJOINT)
+					{
+						continue;
+					}
+
+					inside = containment == DirectX::CONTAINS;
+				}
+
+				if (leaf(index))
+				{
+					func(node.object);
+					continue;
+				}
+
+				stack.emplace(node.left, inside);
+				stack.emplace(node.right, inside);
+			}
+		}
+
+		NodeIndex allocateNode();
+		void      freeNode(NodeIndex index);
+		void      insertLeaf(NodeIndex leaf);
+		void      removeLeaf(NodeIndex leaf);
+		// Refits the bounds and the heights from the given node to the root.
+		void refit(NodeIndex index);
+		// Rotates the taller child up if the node is imbalanced, returns the node that takes the place.
+		NodeIndex balance(NodeIndex index);
+		bool      leaf(NodeIndex index) const;
+
+		static BoundingBox __vectorcall Fatten(const BoundingBox& bounds);
+		static BoundingBox __vectorcall Merge(const BoundingBox& lhs, const BoundingBox& rhs);
+		static float __vectorcall       SurfaceArea(const BoundingBox& bounds);
+
+		NodeIndex              m_root_;
+		std::vector<Node>      m_nodes_;
+		std::vector<NodeIndex> m_free_nodes_;
+
+		std::unordered_map<GlobalEntityID, NodeIndex> m_lookup_;
+	};
+}
@@ -216,6 +216,53 @@ namespace Engine
 		TASK_MAX
 	};
 
+	enum eTaskPriority
+	{
+		// Drained regardless of the time budget, unless an earlier type is carried to the next frame.
+		TASK_PRIORITY_IMMEDIATE = 0,
+		// Drained while the time budget remains, otherwise carried to the next frame.
+		TASK_PRIORITY_BUDGETED,
+	};
+
+	enum eManagerPhase
+	{
+		MANAGER_PHASE_PRE_UPDATE = 0,
+		MANAGER_PHASE_FIXED_UPDATE,
+		MANAGER_PHASE_UPDATE,
+		MANAGER_PHASE_POST_UPDATE,
+		MANAGER_PHASE_PRE_RENDER,
+		MANAGER_PHASE_RENDER,
+		MANAGER_PHASE_POST_RENDER,
+		// Command list submission and present, may overlap with the next frame.
+		MANAGER_PHASE_SUBMIT,
+		MANAGER_PHASE_MAX
+	};
+
+	enum eManagerAccess : UINT
+	{
+		MANAGER_ACCESS_NONE        = 0,
+		MANAGER_ACCESS_INPUT       = 1,
+		MANAGER_ACCESS_SCENE       = 2,
+		MANAGER_ACCESS_TRANSFORM   = 4,
+		MANAGER_ACCESS_RIGIDBODY   = 8,
+		MANAGER_ACCESS_COLLISION   = 16,
+		MANAGER_ACCESS_RESOURCE    = 32,
+		MANAGER_ACCESS_LIGHT       = 64,
+		MANAGER_ACCESS_FRUSTUM     = 128,
+		MANAGER_ACCESS_RENDER_LIST = 256,
+		MANAGER_ACCESS_COMMAND     = 512,
+		MANAGER_ACCESS_AUDIO       = 1024,
+		MANAGER_ACCESS_ALL         = 0xFFFFFFFF,
+	};
+
+	enum eCoroutineWait
+	{
+		COROUTINE_WAIT_NONE = 0,
+		COROUTINE_WAIT_NEXT_FRAME,
+		COROUTINE_WAIT_SECONDS,
+		COROUTINE_WAIT_CONDITION,
+	};
+
 	enum eLayerType
 	{
 		LAYER_NONE = 0,
@@ -412,8 +459,24 @@ namespace Engine
 	{
 		BOUNDING_TYPE_BOX = 0,
 		BOUNDING_TYPE_SPHERE,
+		BOUNDING_TYPE_COUNT
+	};
+
+	enum eSpatialIndexType
+	{
+		SPATIAL_INDEX_OCTREE = 0,
+		SPATIAL_INDEX_AABB_TREE,
+		SPATIAL_INDEX_MAX
 	};
 
+	constexpr const char* g_spatial_index_type_str[] =
+	{
+		"Octree",
+		"AABB Tree",
+	};
+
+	static_assert(ARRAYSIZE(g_spatial_index_type_str) == SPATIAL_INDEX_MAX);
+
 	constexpr const char* g_layer_type_str[] =
 	{
 		"None",
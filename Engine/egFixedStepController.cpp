@@ -0,0 +1,65 @@
+#include "pch.h"
+#include "egFixedStepController.h"
+
+namespace Engine
+{
+	FixedStepController::FixedStepController(const float interval, const UINT max_steps, const float max_debt)
+		: m_interval_(interval),
+		  m_max_steps_(max_steps),
+		  m_max_debt_(max_debt),
+		  m_accumulator_(0.f),
+		  m_alpha_(0.f) {}
+
+	UINT FixedStepController::Advance(const float dt)
+	{
+		m_accumulator_ += dt;
+
+		const auto due   = static_cast<UINT>(m_accumulator_ / m_interval_);
+		const UINT steps = std::min(due, m_max_steps_);
+
+		m_accumulator_ -= static_cast<float>(steps) * m_interval_;
+
+		float dropped = 0.f;
+
+		// Could not catch up within the limit, leave the debt up to the limit and drop the rest.
+		if (m_accumulator_ > m_max_debt_)
+		{
+			dropped        = m_accumulator_ - m_max_debt_;
+			m_accumulator_ = m_max_debt_;
+		}
+
+		if (due > m_max_steps_)
+		{
+			++m_statistics_.clamped_frames;
+		}
+
+		m_alpha_ = std::clamp(m_accumulator_ / m_interval_, 0.f, 1.f);
+
+		m_statistics_.steps   = steps;
+		m_statistics_.dropped = dropped;
+		m_statistics_.total_dropped += dropped;
+
+		return steps;
+	}
+
+	void FixedStepController::Reset()
+	{
+		m_accumulator_ = 0.f;
+		m_alpha_       = 0.f;
+	}
+
+	float FixedStepController::GetInterval() const
+	{
+		return m_interval_;
+	}
+
+	float FixedStepController::GetAlpha() const
+	{
+		return m_alpha_;
+	}
+
+	FixedStepController::Statistics FixedStepController::GetStatistics() const
+	{
+		return m_statistics_;
+	}
+}
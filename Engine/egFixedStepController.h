@@ -0,0 +1,41 @@
+#pragma once
+
+namespace Engine
+{
+	// Splits the frame time into the fixed steps. Steps per frame are limited and the time debt that
+	// cannot be paid is dropped, so that a slow frame does not cause more slow frames.
+	class FixedStepController
+	{
+	public:
+		struct Statistics
+		{
+			// Steps taken in the last frame.
+			UINT steps = 0;
+			// Time dropped in the last frame.
+			float dropped       = 0.f;
+			float total_dropped = 0.f;
+			// Count of the frames which hit the step limit.
+			UINT64 clamped_frames = 0;
+		};
+
+		FixedStepController(float interval, UINT max_steps, float max_debt);
+
+		// Accumulate the frame time and returns the count of the fixed steps to run in this frame.
+		UINT Advance(float dt);
+		void Reset();
+
+		float GetInterval() const;
+		// Progress to the next fixed step, in [0, 1].
+		float      GetAlpha() const;
+		Statistics GetStatistics() const;
+
+	private:
+		float m_interval_;
+		UINT  m_max_steps_;
+		float m_max_debt_;
+
+		float      m_accumulator_;
+		float      m_alpha_;
+		Statistics m_statistics_;
+	};
+}
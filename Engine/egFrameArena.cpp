@@ -0,0 +1,83 @@
+#include "pch.h"
+#include "egFrameArena.hpp"
+
+namespace Engine
+{
+	FrameArena::FrameArena()
+		: m_block_index_(0),
+		  m_offset_(0)
+	{
+		std::lock_guard l(s_registry_lock_);
+		s_registry_.push_back(this);
+	}
+
+	FrameArena::~FrameArena()
+	{
+		std::lock_guard l(s_registry_lock_);
+		std::erase(s_registry_, this);
+	}
+
+	void* FrameArena::Allocate(const size_t size, const size_t alignment)
+	{
+		while (m_block_index_ < m_blocks_.size())
+		{
+			auto&           block   = m_blocks_[m_block_index_];
+			const uintptr_t base    = reinterpret_cast<uintptr_t>(block.data.get());
+			const uintptr_t aligned = Align(base + m_offset_, alignment);
+
+			if (aligned + size <= base + block.size)
+			{
+				m_offset_ = aligned + size - base;
+				return reinterpret_cast<void*>(aligned);
+			}
+
+			++m_block_index_;
+			m_offset_ = 0;
+		}
+
+		// Out of the blocks, allocate a new one with the room for the alignment.
+		const size_t new_size = std::max(block_size, size + alignment);
+		m_blocks_.push_back({std::make_unique<std::byte[]>(new_size), new_size});
+		m_block_index_ = m_blocks_.size() - 1;
+
+		const uintptr_t base    = reinterpret_cast<uintptr_t>(m_blocks_.back().data.get());
+		const uintptr_t aligned = Align(base, alignment);
+		m_offset_               = aligned + size - base;
+
+		return reinterpret_cast<void*>(aligned);
+	}
+
+	void FrameArena::Reset()
+	{
+		m_block_index_ = 0;
+		m_offset_      = 0;
+	}
+
+	size_t FrameArena::GetCapacity() const
+	{
+		size_t capacity = 0;
+
+		for (const auto& block : m_blocks_)
+		{
+			capacity += block.size;
+		}
+
+		return capacity;
+	}
+
+	FrameArena& FrameArena::Local()
+	{
+		thread_local FrameArena arena;
+		return arena;
+	}
+
+	void FrameArena::ResetAll()
+	{
+		std::lock_guard l(s_registry_lock_);
+
+		for (FrameArena* arena : s_registry_)
+		{
+			arena->Reset();
+		}
+	}
+}
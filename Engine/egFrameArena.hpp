@@ -0,0 +1,83 @@
+#pragma once
+#include <map>
+#include <mutex>
+#include <stack>
+#include <vector>
+
+namespace Engine
+{
+	// Linear allocator for the transient containers. Memory is valid until the next ResetAll(), blocks are
+	// kept after reset so that the steady state frames do not touch the general heap.
+	class FrameArena
+	{
+	public:
+		FrameArena();
+		~FrameArena();
+
+		FrameArena(const FrameArena&)            = delete;
+		FrameArena& operator=(const FrameArena&) = delete;
+
+		void*  Allocate(size_t size, size_t alignment);
+		void   Reset();
+		size_t GetCapacity() const;
+
+		// Arena of the calling thread.
+		static FrameArena& Local();
+		// Reset every thread arena. Should be called at the frame boundary where no frame work is running.
+		static void ResetAll();
+
+	private:
+		constexpr static size_t block_size = 256 * 1024;
+
+		struct Block
+		{
+			std::unique_ptr<std::byte[]> data;
+			size_t                       size;
+		};
+
+		std::vector<Block> m_blocks_;
+		size_t             m_block_index_;
+		size_t             m_offset_;
+
+		inline static std::mutex               s_registry_lock_;
+		inline static std::vector<FrameArena*> s_registry_;
+	};
+
+	// Stateless allocator which allocates from the arena of the calling thread, container can be grown
+	// from any thread. Deallocation is deferred to the frame arena reset.
+	template <typename T>
+	struct FrameAllocator
+	{
+		using value_type = T;
+
+		FrameAllocator() noexcept = default;
+
+		template <typename U>
+		FrameAllocator(const FrameAllocator<U>&) noexcept {}
+
+		T* allocate(const size_t n)
+		{
+			return static_cast<T*>(FrameArena::Local().Allocate(sizeof(T) * n, alignof(T)));
+		}
+
+		void deallocate(T*, size_t) noexcept {}
+
+		template <typename U>
+		bool operator==(const FrameAllocator<U>&) const noexcept
+		{
+			return true;
+		}
+	};
+
+	template <typename ValueType>
+	using frame_vector = std::vector<ValueType, FrameAllocator<ValueType>>;
+
+	template <typename ValueType>
+	using frame_stack = std::stack<ValueType, frame_vector<ValueType>>;
+
+	template <typename KeyType, typename ValueType>
+	using frame_map = std::map<KeyType, ValueType, std::less<KeyType>, FrameAllocator<std::pair<const KeyType, ValueType>>>;
+
+	template <typename KeyType, typename ValueType>
+	using frame_concurrent_hash_map = concurrent_hash_map<KeyType, ValueType, tbb::tbb_hash_compare<KeyType>, FrameAllocator<std::pair<const KeyType, ValueType>>>;
+}
@@ -336,6 +336,23 @@ namespace Engine::Physics
 			return std::sqrtf(Vector3::DistanceSquared(m_boundings_.box.Center, point));
 		}
 
+		// Axis-aligned box that encloses the bounding.
+		[[nodiscard]] BoundingBox __vectorcall GetAABB() const
+		{
+			BoundingBox aabb;
+
+			if (type == BOUNDING_TYPE_SPHERE)
+			{
+				BoundingBox::CreateFromSphere(aabb, m_boundings_.sphere);
+				return aabb;
+			}
+
+			Vector3 corners[BoundingOrientedBox::CORNER_COUNT];
+			m_boundings_.box.GetCorners(corners);
+			BoundingBox::CreateFromPoints(aabb, BoundingOrientedBox::CORNER_COUNT, corners, sizeof(Vector3));
+			return aabb;
+		}
+
 	private:
 		friend class boost::serialization::access;
 
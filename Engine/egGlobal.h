@@ -13,6 +13,14 @@ namespace Engine
 	inline std::atomic<UINT>  g_frame_buffer  = 2;
 	inline std::atomic<bool>  g_raytracing    = false;
 
+	// Engine Modifier
+	// Run non-conflicting managers in parallel, otherwise managers are run in the declared order.
+	inline std::atomic<bool> g_parallel_managers = true;
+	// Submit the frame in the workers while the next frame's fixed updates are running.
+	inline std::atomic<bool> g_pipelined_render = false;
+	// Time budget for draining the deferred tasks per frame in microseconds, 0 for unlimited.
+	inline std::atomic<UINT> g_task_budget_us = 2000;
+
 	// Debugging Modifier
 	inline std::atomic<bool> g_paused      = false;
 	inline std::atomic<bool> g_camera_lock = false;
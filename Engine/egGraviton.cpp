@@ -2,6 +2,7 @@
 #include "egGraviton.h"
 
 #include "egBaseCollider.hpp"
+#include "egManagerHelper.hpp"
 #include "egRigidbody.h"
 #include "egSceneManager.hpp"
 
@@ -17,38 +18,39 @@ namespace Engine::Manager::Physics
 	{
 		if (const auto scene = GetSceneManager().GetActiveScene().lock())
 		{
-			const auto& comps = scene->GetCachedComponents<Components::Rigidbody>();
-
-			for (const auto& ptr_comp : comps)
-			{
-				if (const auto comp = ptr_comp.lock())
-				{
-					const auto& rb = comp->GetSharedPtr<Components::Rigidbody>();
-
-					if (rb->IsFixed())
-					{
-						continue;
-					}
-					if (!rb->IsGravityAllowed())
-					{
-						continue;
-					}
-					if (rb->GetGrounded())
-					{
-						continue;
-					}
-					if (!rb->GetActive())
-					{
-						continue;
-					}
-
-					const auto cl   = rb->GetOwner().lock()->GetComponent<Components::Collider>().lock();
-					const auto drag = Engine::Physics::EvalDrag(rb->GetT0LinearVelocity(), g_drag_coefficient);
-
-					rb->AddT1Force((g_gravity_vec * cl->GetInverseMass()) + (drag * cl->GetInverseMass()));
-					rb->SetDragForce(drag);
-				}
-			}
+			const auto& rbs = scene->GetLockedComponents<Components::Rigidbody>();
+
+			// Each body only touches its own state.
+			GetTaskScheduler().ParallelFor
+					(
+					 rbs.size(), [&rbs](const size_t i)
+					 {
+						 const auto& rb = rbs[i];
+
+						 if (rb->IsFixed())
+						 {
+							 return;
+						 }
+						 if (!rb->IsGravityAllowed())
+						 {
+							 return;
+						 }
+						 if (rb->GetGrounded())
+						 {
+							 return;
+						 }
+						 if (!rb->GetActive())
+						 {
+							 return;
+						 }
+
+						 const auto cl   = rb->GetOwner().lock()->GetComponent<Components::Collider>().lock();
+						 const auto drag = Engine::Physics::EvalDrag(rb->GetT0LinearVelocity(), g_drag_coefficient);
+
+						 rb->AddT1Force((g_gravity_vec * cl->GetInverseMass()) + (drag * cl->GetInverseMass()));
+						 rb->SetDragForce(drag);
+					 }, g_rigidbody_parallel_grain
+					);
 		}
 	}
 
@@ -59,4 +61,15 @@ namespace Engine::Manager::Physics
 	void Graviton::PostRender(const float& dt) {}
 
 	void Graviton::Initialize() {}
+
+	ManagerAccess Graviton::GetAccess(const eManagerPhase phase) const
+	{
+		switch (phase)
+		{
+		case MANAGER_PHASE_FIXED_UPDATE:
+			return {MANAGER_ACCESS_SCENE | MANAGER_ACCESS_COLLISION, MANAGER_ACCESS_RIGIDBODY};
+		default:
+			return g_manager_access_none;
+		}
+	}
 }
@@ -16,6 +16,7 @@ namespace Engine::Manager::Physics
 		void Render(const float& dt) override;
 		void PostRender(const float& dt) override;
 		void Initialize() override;
+		ManagerAccess GetAccess(eManagerPhase phase) const override;
 
 	private:
 		friend struct SingletonDeleter;
@@ -104,4 +104,16 @@ namespace Engine::Manager::Graphics
 	}
 
 	void ImGuiManager::Update(const float& dt) {}
+
+	ManagerAccess ImGuiManager::GetAccess(const eManagerPhase phase) const
+	{
+		switch (phase)
+		{
+		case MANAGER_PHASE_RENDER:
+		case MANAGER_PHASE_SUBMIT:
+			return g_manager_access_exclusive;
+		default:
+			return g_manager_access_none;
+		}
+	}
 }
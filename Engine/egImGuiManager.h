@@ -9,6 +9,7 @@ namespace Engine::Manager::Graphics
 		explicit ImGuiManager(SINGLETON_LOCK_TOKEN) {}
 
 		void Initialize(HWND hwnd) override;
+		ManagerAccess GetAccess(eManagerPhase phase) const override;
 		void PreUpdate(const float& dt) override;
 		void Update(const float& dt) override;
 		void PreRender(const float& dt) override;
@@ -8,30 +8,12 @@
 namespace Engine::Manager::Physics
 {
 	LerpManager::LerpManager(SINGLETON_LOCK_TOKEN)
-		: Singleton(),
-		  m_elapsed_time_(0.f) {}
+		: Singleton() {}
 
-	void LerpManager::Initialize()
-	{
-		m_elapsed_time_ = 0.f;
-	}
+	void LerpManager::Initialize() {}
 
 	void LerpManager::Update(const float& dt) {}
 
-	void LerpManager::Reset()
-	{
-		// modff = divide integer part and fractional part
-		const float f = std::fmod(m_elapsed_time_, g_fixed_update_interval);
-		if (f > 0.f)
-		{
-			m_elapsed_time_ = f;
-		}
-		else
-		{
-			m_elapsed_time_ = 0.f;
-		}
-	}
-
 	void LerpManager::PreUpdate(const float& dt) {}
 
 	void LerpManager::PreRender(const float& dt) {}
@@ -40,10 +22,7 @@ namespace Engine::Manager::Physics
 
 	void LerpManager::PostRender(const float& dt) {}
 
-	void LerpManager::FixedUpdate(const float& dt)
-	{
-		Reset();
-	}
+	void LerpManager::FixedUpdate(const float& dt) {}
 
 	void LerpManager::PostUpdate(const float& dt)
 	{
@@ -54,57 +33,64 @@ namespace Engine::Manager::Physics
 				return;
 			}
 
-			const auto& rbs = scene->GetCachedComponents<Components::Rigidbody>();
-
-			for (const auto& rb : rbs)
-			{
-				if (const auto rigidbody = rb.lock())
-				{
-					if (!rigidbody->GetActive())
-					{
-						continue;
-					}
-					if (rigidbody->GetSharedPtr<Components::Rigidbody>()->IsFixed())
-					{
-						continue;
-					}
-					if (!rigidbody->GetSharedPtr<Components::Rigidbody>()->GetLerp())
-					{
-						continue;
-					}
-
-					const auto t0 = rigidbody->GetOwner().lock()->GetComponent<Components::Transform>().lock();
-					const auto t1 = rigidbody->GetSharedPtr<Components::Rigidbody>()->GetT1();
-
-					if (t0 && t1)
-					{
-						const auto t0pos = t0->GetLocalPosition();
-						const auto t1pos = t1->GetLocalPosition();
-						const auto f     = GetLerpFactor();
-						const auto lerp  = Vector3::Lerp(t0pos, t1pos, f);
-						Vector3CheckNanException(lerp);
-
-						const auto t0rot = t0->GetLocalRotation();
-						const auto t1rot = t1->GetLocalRotation();
-						const auto slerp = Quaternion::Slerp(t0rot, t1rot, f);
-
-						t0->SetLocalPosition(lerp);
-						t0->SetLocalRotation(slerp);
-					}
-				}
-			}
+			const auto& rbs = scene->GetLockedComponents<Components::Rigidbody>();
+			const auto  f   = GetLerpFactor();
+
+			// Each body only writes its own transform.
+			GetTaskScheduler().ParallelFor
+					(
+					 rbs.size(), [&rbs, f](const size_t i)
+					 {
+						 const auto& rigidbody = rbs[i];
+
+						 if (!rigidbody->GetActive())
+						 {
+							 return;
+						 }
+						 if (rigidbody->IsFixed())
+						 {
+							 return;
+						 }
+						 if (!rigidbody->GetLerp())
+						 {
+							 return;
+						 }
+
+						 const auto t0 = rigidbody->GetOwner().lock()->GetComponent<Components::Transform>().lock();
+						 const auto t1 = rigidbody->GetT1();
+
+						 if (t0 && t1)
+						 {
+							 const auto t0pos = t0->GetLocalPosition();
+							 const auto t1pos = t1->GetLocalPosition();
+							 const auto lerp  = Vector3::Lerp(t0pos, t1pos, f);
+							 Vector3CheckNanException(lerp);
+
+							 const auto t0rot = t0->GetLocalRotation();
+							 const auto t1rot = t1->GetLocalRotation();
+							 const auto slerp = Quaternion::Slerp(t0rot, t1rot, f);
+
+							 t0->SetLocalPosition(lerp);
+							 t0->SetLocalRotation(slerp);
+						 }
+					 }, g_rigidbody_parallel_grain
+					);
 		}
-
-		m_elapsed_time_ += dt;
 	}
 
 	float LerpManager::GetLerpFactor() const
 	{
-		const auto f = m_elapsed_time_ / g_fixed_update_interval;
-		if (!isfinite(f))
+		return GetApplication().GetFixedStep().GetAlpha();
+	}
+
+	ManagerAccess LerpManager::GetAccess(const eManagerPhase phase) const
+	{
+		switch (phase)
 		{
-			return g_epsilon_squared;
+		case MANAGER_PHASE_POST_UPDATE:
+			return {MANAGER_ACCESS_SCENE | MANAGER_ACCESS_RIGIDBODY, MANAGER_ACCESS_TRANSFORM};
+		default:
+			return g_manager_access_none;
 		}
-		return f;
 	}
 } // namespace Engine::Manager::Physics
@@ -9,9 +9,8 @@ namespace Engine::Manager::Physics
 		LerpManager(SINGLETON_LOCK_TOKEN);
 
 		void Initialize() override;
+		ManagerAccess GetAccess(eManagerPhase phase) const override;
 		void Update(const float& dt) override;
-
-		void Reset();
 		void PreUpdate(const float& dt) override;
 		void PreRender(const float& dt) override;
 		void Render(const float& dt) override;
@@ -19,13 +18,12 @@ namespace Engine::Manager::Physics
 		void FixedUpdate(const float& dt) override;
 		void PostUpdate(const float& dt) override;
 
+		// Interpolation alpha of the fixed step controller.
 		float GetLerpFactor() const;
 
 	private:
 		friend struct SingletonDeleter;
 		~LerpManager() override = default;
-
-		float m_elapsed_time_;
 	};
 } // namespace Engine::Manager::Physics
 
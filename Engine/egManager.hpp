@@ -3,6 +3,36 @@
 #include "egRenderable.h"
 #include "egType.h"
 
+namespace Engine
+{
+	// Shared data that the manager reads and writes in a phase. Managers which touch the same data
+	// with at least one write are not executed concurrently.
+	struct ManagerAccess
+	{
+		eManagerAccesses reads;
+		eManagerAccesses writes;
+
+		[[nodiscard]] bool Conflicts(const ManagerAccess& other) const
+		{
+			return (writes & (other.reads | other.writes)) || (other.writes & reads);
+		}
+
+		// Undeclared access, needs to run alone in the main thread.
+		[[nodiscard]] bool Exclusive() const
+		{
+			return writes == MANAGER_ACCESS_ALL;
+		}
+
+		[[nodiscard]] bool Empty() const
+		{
+			return reads == MANAGER_ACCESS_NONE && writes == MANAGER_ACCESS_NONE;
+		}
+	};
+
+	constexpr ManagerAccess g_manager_access_none      = {MANAGER_ACCESS_NONE, MANAGER_ACCESS_NONE};
+	constexpr ManagerAccess g_manager_access_exclusive = {MANAGER_ACCESS_ALL, MANAGER_ACCESS_ALL};
+}
+
 namespace Engine::Abstract
 {
 	template <typename T, typename... InitArgs>
@@ -13,8 +43,14 @@ namespace Engine::Abstract
 		Singleton(Singleton&&)                 = delete;
 		Singleton& operator=(const Singleton&) = delete;
 
-		static constexpr T& GetInstance()
+		static T& GetInstance()
 		{
+			// Fast path, instance is published once and read without the lock afterwards.
+			if (T* instance = s_published_.load(std::memory_order_acquire))
+			{
+				return *instance;
+			}
+
 			std::lock_guard l(s_mutex_);
 
 			if (s_instance_ == nullptr || s_destroyed_)
@@ -23,19 +59,22 @@ namespace Engine::Abstract
 				s_instance_ = std::unique_ptr<T, SingletonDeleter>(new T(SINGLETON_LOCK_TOKEN{}));
 				std::call_once(s_first_call_, std::atexit, &Destroy);
 				s_destroyed_ = false;
+				s_published_.store(s_instance_.get(), std::memory_order_release);
 			}
 
 			return *s_instance_;
 		}
 
 		/**
-		 * \brief Free the singleton instance manually.
+		 * \brief Free the singleton instance manually. Caller should ensure that no other thread is
+		 * accessing the instance, the lock-free path does not guard the lifetime.
 		 */
 		static void Destroy()
 		{
 			std::lock_guard l(s_mutex_);
 			if (s_instance_ || !s_destroyed_)
 			{
+				s_published_.store(nullptr, std::memory_order_release);
 				s_instance_.reset();
 				s_destroyed_ = true;
 			}
@@ -43,6 +82,13 @@ namespace Engine::Abstract
 
 		virtual void Initialize(InitArgs... args) = 0;
 
+		// Declares the data that is accessed in the given phase. Manager is treated as exclusive
+		// if it is not declared.
+		virtual ManagerAccess GetAccess(eManagerPhase phase) const
+		{
+			return g_manager_access_exclusive;
+		}
+
 		void OnSerialized() final {}
 		void OnDeserialized() final {}
 		void OnImGui() override {}
@@ -57,6 +103,7 @@ namespace Engine::Abstract
 		{
 			static_assert(SingletonChecker::dtor, "Singleton should not have destructor as public");
 			s_destroyed_ = true;
+			s_published_.store(nullptr, std::memory_order_release);
 		}
 
 		struct SINGLETON_LOCK_TOKEN final {};
@@ -81,5 +128,6 @@ namespace Engine::Abstract
 		inline static std::once_flag                       s_first_call_;
 		inline static std::atomic<bool>                    s_destroyed_ = true;
 		inline static std::mutex                           s_mutex_     = std::mutex();
+		inline static std::atomic<T*>                      s_published_ = nullptr;
 	};
 } // namespace Engine::Abstract
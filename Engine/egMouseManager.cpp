@@ -66,4 +66,16 @@ namespace Engine::Manager
 	{
 		return m_mouse_rot_y_;
 	}
+
+	ManagerAccess MouseManager::GetAccess(const eManagerPhase phase) const
+	{
+		switch (phase)
+		{
+		case MANAGER_PHASE_PRE_UPDATE:
+		case MANAGER_PHASE_POST_UPDATE:
+			return {MANAGER_ACCESS_NONE, MANAGER_ACCESS_INPUT};
+		default:
+			return g_manager_access_none;
+		}
+	}
 } // namespace Engine::Manager
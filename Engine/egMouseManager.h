@@ -9,6 +9,7 @@ namespace Engine::Manager
 		MouseManager(SINGLETON_LOCK_TOKEN)
 			: Singleton<MouseManager>() {};
 		void Initialize() override;
+		ManagerAccess GetAccess(eManagerPhase phase) const override;
 		void PreUpdate(const float& dt) override;
 		void Update(const float& dt) override;
 		void PreRender(const float& dt) override;
@@ -125,11 +125,10 @@ namespace Engine::Abstract
 
 		GetTaskScheduler().AddTask
 				(
-				 TASK_ADD_CHILD, {p_child}, [this](auto& params, const auto dt)
+				 TASK_ADD_CHILD, [this](const WeakObjectBase& cast_child, const float dt)
 				 {
-					 const auto& cast_child = std::any_cast<WeakObjectBase>(params[0]);
 					 addChildImpl(cast_child);
-				 }
+				 }, p_child
 				);
 	}
 
@@ -170,10 +169,10 @@ namespace Engine::Abstract
 			{
 				GetTaskScheduler().AddTask
 						(
-						 TASK_REM_CHILD, {id}, [this](auto& params, const auto dt)
+						 TASK_REM_CHILD, [this](const LocalActorID child_id, const float dt)
 						 {
-							 detachChildImpl(std::any_cast<LocalActorID>(params[0]));
-						 }
+							 detachChildImpl(child_id);
+						 }, id
 						);
 			}
 
@@ -285,12 +284,8 @@ namespace Engine::Abstract
 			GetTaskScheduler().AddTask
 					(
 					 TASK_REM_SCRIPT,
-					 {GetSharedPtr<ObjectBase>(), type},
-					 [](const std::vector<std::any>& params, const float)
+					 [](const StrongObjectBase& obj, const eScriptType type, const float)
 					 {
-						 const auto& obj  = std::any_cast<StrongObjectBase>(params[0]);
-						 const auto& type = std::any_cast<eScriptType>(params[1]);
-
 						 std::erase_if
 								 (
 								  obj->m_cached_script_, [type](const auto& script)
@@ -304,7 +299,8 @@ namespace Engine::Abstract
 								  }
 								 );
 						 obj->m_scripts_.erase(type);
-					 }
+					 },
+					 GetSharedPtr<ObjectBase>(), type
 					);
 		}
 	}
@@ -381,17 +377,13 @@ namespace Engine::Abstract
 		GetTaskScheduler().AddTask
 				(
 				 TASK_REM_COMPONENT,
-				 {GetSharedPtr<ObjectBase>(), comp, type},
-				 [](const std::vector<std::any>& params, const float)
+				 [](const StrongObjectBase& obj, const StrongComponent& comp, const eComponentType type, const float)
 				 {
-					 const auto& obj  = std::any_cast<StrongObjectBase>(params[0]);
-					 const auto& comp = std::any_cast<StrongComponent>(params[1]);
-					 const auto& type = std::any_cast<eComponentType>(params[2]);
-
 					 obj->m_assigned_component_ids_.erase(comp->GetLocalID());
 					 obj->m_cached_component_.erase(comp);
 					 obj->m_components_.erase(type);
-				 }
+				 },
+				 GetSharedPtr<ObjectBase>(), comp, type
 				);
 	}
 
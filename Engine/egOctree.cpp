@@ -7,490 +7,392 @@
 namespace Engine
 {
 	Octree::Octree()
-		: m_parent_(nullptr),
-		  m_bounds_(Vector3::Zero, map_size_vec), // Root node is the whole map
-		  m_b_initialized_(false),
-		  m_life_count_(node_lifespan) {}
-
-	// Deep copying
-	Octree::Octree(const Octree& other)
-		: m_parent_(other.m_parent_),
-		  m_active_children_(other.m_active_children_),
-		  m_values_(other.m_values_),
-		  m_bounds_(other.m_bounds_),
-		  m_insertion_queue_(other.m_insertion_queue_),
-		  m_b_initialized_(other.m_b_initialized_),
-		  m_life_count_(other.m_life_count_)
-	{
-		for (int i = 0; i < octant_count; ++i)
-		{
-			if (other.m_children_[i])
-			{
-				m_children_[i]            = std::make_unique<Octree>(*other.m_children_[i]);
-				m_children_[i]->m_parent_ = this;
-			}
-		}
+	{
+		// Root node is the whole map
+		Node root;
+		root.bounds     = BoundingBox(Vector3::Zero, map_size_vec);
+		root.loose      = GetLoose(root.bounds);
+		root.life_count = node_lifespan;
+		root.alive      = true;
+		root.children.fill(invalid_node);
+
+		m_nodes_.push_back(std::move(root));
 	}
 
-	const std::vector<Octree::WeakT>& Octree::Read() const
+	const Octree::Node& Octree::GetNode(const NodeIndex index) const
 	{
-		return m_values_;
+		return m_nodes_[index];
 	}
 
-	std::array<const Octree*, 8> Octree::Next() const
+	const Octree::Entry& Octree::GetEntry(const EntryIndex index) const
 	{
-		std::array<const Octree*, 8> next;
+		return m_entries_[index];
+	}
 
-		for (int i = 0; i < octant_count; ++i)
-		{
-			if (m_children_[i])
-			{
-				next[i] = m_children_[i].get();
-			}
-			else
-			{
-				next[i] = nullptr;
-			}
-		}
+	size_t Octree::GetNodeCount() const
+	{
+		return m_nodes_.size() - m_free_nodes_.size();
+	}
+
+	eSpatialIndexType Octree::GetType() const
+	{
+		return SPATIAL_INDEX_OCTREE;
+	}
 
-		return next;
+	size_t Octree::GetCount() const
+	{
+		return m_lookup_.size();
 	}
 
 	bool Octree::Contains(const Vector3& point) const
 	{
-		return m_bounds_.Contains(point) == DirectX::ContainmentType::CONTAINS;
+		return m_nodes_[root_node].bounds.Contains(point) == DirectX::ContainmentType::CONTAINS;
 	}
 
 	float Octree::Distance(const Vector3& point) const
 	{
-		return std::sqrtf(Vector3::DistanceSquared(m_bounds_.Center, point));
+		return std::sqrtf(Vector3::DistanceSquared(m_nodes_[root_node].bounds.Center, point));
 	}
 
 	UINT Octree::ActiveChildren() const
 	{
-		return static_cast<UINT>(m_active_children_.count());
+		UINT count = 0;
+
+		for (const NodeIndex child : m_nodes_[root_node].children)
+		{
+			count += child != invalid_node;
+		}
+
+		return count;
 	}
 
 	bool Octree::Insert(const WeakT& obj)
 	{
-		// attempt to insert outside of the map
-		if (this == nullptr)
-		{
-			return false;
-		}
+		const auto locked = obj.lock();
 
-		if (!m_b_initialized_)
+		if (!locked)
 		{
-			m_insertion_queue_.push(obj);
-			Build();
-			return true;
+			return false;
 		}
 
-		// This will be the last node that successfully contains the object
-		Octree*             last = nullptr;
-		std::stack<Octree*> stack;
-		stack.push(this);
-
-		// exact match (which is the smallest node that can contain the object)
-		bool found = false;
-
-		const auto bounding_value = bounding_getter::value(*obj.lock());
+		const Physics::GenericBounding bounding = bounding_getter::value(*locked);
+		const BoundingBox              bounds   = bounding.GetAABB();
 
-		while (!stack.empty())
+		// Already in the tree, refresh the bounds.
+		if (const auto it = m_lookup_.find(locked->GetID()); it != m_lookup_.end())
 		{
-			const auto node = stack.top();
-			last            = node;
-			stack.pop();
-
-			const auto& node_active_flag     = node->m_b_initialized_;
-			auto&       node_active_children = node->m_active_children_;
-			const auto& node_parent          = node->m_parent_;
-			auto&       node_children        = node->m_children_;
-			auto&       node_value           = node->m_values_;
-			const auto& node_bound           = node->m_bounds_;
-			const auto& node_extent          = node->Extent();
-			const auto& node_center          = node->WorldCenter();
-
-			if (!node_active_flag)
-			{
-				node->UpdateInternal();
-			}
-
-			const Vector3        extent_scale = node_extent * 2.f;
-			const std::bitset<3> floor_bit
-					(
-					 (extent_scale.x <= smallest_scale) +
-					 ((extent_scale.y <= smallest_scale) << 1) +
-					 ((extent_scale.z <= smallest_scale) << 2)
-					);
+			m_entries_[it->second].bounds   = bounds;
+			m_entries_[it->second].bounding = bounding;
+			relocate(it->second);
+			sense(locked->GetID(), obj, bounds);
 
-			// possibly the smallest node that can contain the object
-			if (floor_bit.all())
-			{
-				node_value.push_back(obj);
-				found = true;
-				break;
-			}
-
-			// Check whether the object is bounded by the node
-			if (bounding_value.ContainsBy(node_bound) == DirectX::CONTAINS)
-			{
-				// Try to insert into children for more precise containment
-				for (int i = 0; i < octant_count; ++i)
-				{
-					// See if there is any child that can contain the object
-					if (node_children[i])
-					{
-						if (bounding_value.ContainsBy(node_children[i]->m_bounds_) ==
-						    DirectX::CONTAINS)
-						{
-							node_active_children.set(i);
-							stack.push(node_children[i].get());
-							break;
-						}
-					}
-					else
-					{
-						const auto bound       = GetBound(node_extent, node_center, static_cast<eOctant>(i));
-						const auto bound_check = bounding_value.ContainsBy(bound);
-
-						if (bound_check == DirectX::ContainmentType::CONTAINS)
-						{
-							// Expand the node and check same above
-							node_children[i]            = std::unique_ptr<Octree>(new Octree{bound});
-							node_children[i]->m_parent_ = node;
-							node_children[i]->Build();
-							node_active_children.set(i);
-							stack.push(node_children[i].get());
-							break;
-						}
-					}
-				}
-			}
+			return true;
 		}
 
-		if (found)
+		// attempt to insert outside of the map
+		if (m_nodes_[root_node].bounds.Contains(bounds.Center) == DirectX::ContainmentType::DISJOINT)
 		{
-			return true;
+			return false;
 		}
-		if (!found && last)
+
+		EntryIndex index;
+
+		if (!m_free_entries_.empty())
 		{
-			last->m_values_.push_back(obj);
-			return true;
+			index = m_free_entries_.back();
+			m_free_entries_.pop_back();
 		}
-		if (!last && bounding_value.ContainsBy(root()->m_bounds_))
+		else
 		{
-			root()->m_values_.push_back(obj);
-			return true;
+			index = static_cast<EntryIndex>(m_entries_.size());
+			m_entries_.emplace_back();
 		}
 
-		// there is not match with current object (oob)
-		return false;
+		Entry& entry   = m_entries_[index];
+		entry.id       = locked->GetID();
+		entry.bounds   = bounds;
+		entry.bounding = bounding;
+		entry.object   = obj;
+
+		m_lookup_[entry.id] = index;
+		attach(index, locate(bounds, root_node));
+		sense(entry.id, obj, bounds);
+
+		return true;
 	}
 
 	void Octree::Remove(const WeakT& obj)
 	{
-		std::stack<Octree*> stack;
-		stack.push(this);
+		const auto locked = obj.lock();
 
-		while (!stack.empty())
+		if (!locked)
 		{
-			const auto node = stack.top();
-			stack.pop();
-
-			auto&       node_value           = node->m_values_;
-			auto&       node_children        = node->m_children_;
-			auto&       node_active_children = node->m_active_children_;
-			const auto& node_bound           = node->m_bounds_;
-			const auto& node_extent          = node->Extent();
-			const auto& node_center          = node->WorldCenter();
+			return;
+		}
 
-			if (!node_value.empty())
-			{
-				for (auto it = node_value.begin(); it != node_value.end();)
-				{
-					if (it->expired())
-					{
-						it = node_value.erase(it);
-						continue;
-					}
+		if (const auto it = m_lookup_.find(locked->GetID()); it != m_lookup_.end())
+		{
+			unsense(locked->GetID());
+			release(it->second);
+		}
+	}
 
-					if (it->lock() == obj.lock())
-					{
-						it = node_value.erase(it);
-						continue;
-					}
+	void Octree::Update()
+	{
+		// Only the moved objects are relocated, the others stay in place.
+		StrongObjectBase obj;
 
-					++it;
-				}
-			}
+		clearSensorEvents();
 
-			for (int i = 0; i < octant_count; ++i)
+		while (popMoved(obj))
+		{
+			if (const auto it = m_lookup_.find(obj->GetID()); it != m_lookup_.end())
 			{
-				if (node_children[i])
-				{
-					if (node_children[i]->garbage())
-					{
-						node_children[i].reset();
-						node_active_children.reset(i);
-					}
-					else
-					{
-						stack.push(node_children[i].get());
-					}
-				}
+				Entry& entry   = m_entries_[it->second];
+				entry.bounding = bounding_getter::value(*obj);
+				entry.bounds   = entry.bounding.GetAABB();
+				relocate(it->second);
+				sense(entry.id, entry.object, entry.bounds);
 			}
 		}
-	}
-
-	void Octree::Update()
-	{
-		unsigned attempt = 0;
 
-		// todo: check whether the node is orphan.
+		collect();
 
-		std::stack<Octree*>     stack;
-		std::map<Octree*, bool> visited;
+		if constexpr (g_debug)
+		{
+			VisitNodes
+					(
+					 [this](const NodeIndex index)
+					 {
+						 GetDebugger().Draw(m_nodes_[index].bounds, DirectX::Colors::BlanchedAlmond);
+					 }
+					);
+		}
+	}
 
-		stack.push(this);
+	void Octree::Clear()
+	{
+		Node root = std::move(m_nodes_[root_node]);
+		root.entries.clear();
+		root.children.fill(invalid_node);
+		root.life_count = node_lifespan;
+
+		m_nodes_.clear();
+		m_free_nodes_.clear();
+		m_entries_.clear();
+		m_free_entries_.clear();
+		m_lookup_.clear();
+		m_empty_nodes_.clear();
+
+		// Pending notifications are of the objects that are no longer in the tree.
+		clearMoved();
+		leaveSensors();
+
+		m_nodes_.push_back(std::move(root));
+	}
 
-		while (!stack.empty())
+	void Octree::Build(const std::span<const WeakT> objects)
+	{
+		Clear();
+
+		std::vector<Physics::GenericBounding> boundings(objects.size());
+		std::vector<BoundingBox>              bounds(objects.size());
+		std::vector<MortonKey>                keys(objects.size());
+		std::vector<char>                     valid(objects.size(), false);
+
+		tbb::parallel_for
+				(
+				 static_cast<size_t>(0), objects.size(), [&](const size_t i)
+				 {
+					 keys[i].index = static_cast<UINT>(i);
+
+					 const auto locked = objects[i].lock();
+
+					 if (!locked)
+					 {
+						 return;
+					 }
+
+					 boundings[i] = bounding_getter::value(*locked);
+					 bounds[i]    = boundings[i].GetAABB();
+
+					 // attempt to insert outside of the map
+					 if (m_nodes_[root_node].bounds.Contains(bounds[i].Center) == DirectX::ContainmentType::DISJOINT)
+					 {
+						 return;
+					 }
+
+					 keys[i].code  = Encode(bounds[i].Center);
+					 keys[i].depth = GetFitDepth(bounds[i]);
+					 valid[i]      = true;
+				 }
+				);
+
+		std::erase_if
+				(
+				 keys, [&valid](const MortonKey& key)
+				 {
+					 return !valid[key.index];
+				 }
+				);
+
+		RadixSort(keys);
+
+		// Path of the nodes for the previous code. Sorted codes share the prefix with the previous one, so
+		// each node is created once and the entries of a node are adjacent.
+		std::array<NodeIndex, max_depth + 1> path{};
+		UINT                                 path_depth = 0;
+		UINT64                               prev_code  = 0;
+
+		path[0] = root_node;
+		m_entries_.reserve(keys.size());
+
+		for (const MortonKey& key : keys)
 		{
-			const auto node = stack.top();
+			const auto locked = objects[key.index].lock();
 
-			auto&       life_count           = node->m_life_count_;
-			auto&       node_value           = node->m_values_;
-			auto&       node_children        = node->m_children_;
-			auto&       node_active_children = node->m_active_children_;
-			auto&       node_bound           = node->m_bounds_;
-			const auto& node_extent          = node->Extent();
-			const auto& node_center          = node->WorldCenter();
+			if (m_lookup_.contains(locked->GetID()))
+			{
+				continue;
+			}
 
-			if (visited.contains(node) && visited[node])
+			// Levels that the code shares with the previous one.
+			while (path_depth > 0 &&
+			       (key.code >> (3 * (max_depth - path_depth))) != (prev_code >> (3 * (max_depth - path_depth))))
 			{
-				if (!node_value.empty())
-				{
-					// Check whether the objects are still bounded by the node
-					for (auto it = node_value.begin(); it != node_value.end();)
-					{
-						if (it->expired())
-						{
-							it = node_value.erase(it);
-							continue;
-						}
-
-						const auto obj         = it->lock();
-						const auto obj_bound   = bounding_getter::value(*obj);
-						const auto bound_check = obj_bound.ContainsBy(node_bound);
-
-						if (bound_check != DirectX::ContainmentType::CONTAINS)
-						{
-							auto* cursor = node->parent();
-
-							while (cursor)
-							{
-								if (cursor->Insert(obj))
-								{
-									break;
-								}
-
-								cursor = cursor->parent();
-							}
-
-							if (!cursor)
-							{
-								// panic: Even root cannot contains the object, need to rebuild the whole tree.
-								root()->Panic();
-								return;
-							}
-							// Object moved to parent node, remove from current obj
-							it = node_value.erase(it);
-							continue;
-						}
-
-						++it;
-					}
-				}
+				--path_depth;
+			}
 
-				for (int i = 0; i < octant_count; ++i)
-				{
-					if (node_children[i])
-					{
-						if (node_children[i]->garbage())
-						{
-							node_children[i].reset();
-							node_active_children.reset(i);
-						}
-					}
-				}
+			for (UINT depth = path_depth + 1; depth <= key.depth; ++depth)
+			{
+				const auto region = static_cast<eOctant>((key.code >> (3 * (max_depth - depth))) & 7);
+				NodeIndex  child  = m_nodes_[path[depth - 1]].children[static_cast<size_t>(region)];
 
-				if constexpr (g_debug)
+				if (child == invalid_node)
 				{
-					GetDebugger().Draw(node_bound, DirectX::Colors::BlanchedAlmond);
+					child = allocateNode(path[depth - 1], region);
 				}
 
-				stack.pop();
-				continue;
+				path[depth] = child;
 			}
 
-			if (!visited.contains(node) && !visited[node])
-			{
-				if (!node->m_b_initialized_)
-				{
-					node->UpdateInternal();
-				}
+			path_depth = std::max(path_depth, key.depth);
+			prev_code  = key.code;
 
-				while (!node->ready())
-				{
-					if (attempt > retry_exhaust)
-					{
-						throw std::logic_error("Octree update failed.");
-					}
+			const auto index = static_cast<EntryIndex>(m_entries_.size());
+			Entry&     entry = m_entries_.emplace_back();
+			entry.id         = locked->GetID();
+			entry.bounds     = bounds[key.index];
+			entry.bounding   = boundings[key.index];
+			entry.object     = objects[key.index];
 
-					node->UpdateInternal();
-					++attempt;
-				}
-
-				// Lifecycle management
-				if (node->empty())
-				{
-					life_count--;
-				}
-				else
-				{
-					life_count = node_lifespan;
-				}
+			m_lookup_[entry.id] = index;
+			attach(index, path[key.depth]);
+		}
 
-				if (!node_value.empty())
-				{
-					for (auto it = node_value.begin(); it != node_value.end();)
-					{
-						if (it->expired())
-						{
-							it = node_value.erase(it);
-							continue;
-						}
-
-						const auto obj       = it->lock();
-						const auto obj_bound = bounding_getter::value(*obj);
-						bool       found     = false;
-
-						for (int i = 0; i < octant_count; ++i)
-						{
-							if (node_children[i])
-							{
-								if (obj_bound.ContainsBy(node_children[i]->m_bounds_) ==
-								    DirectX::ContainmentType::CONTAINS)
-								{
-									// Move the object to the child node for precise boundary
-									if (node_children[i]->Insert(obj))
-									{
-										found = true;
-										break;
-									}
-								}
-							}
-							else
-							{
-								const auto bound       = GetBound(node_extent, node_center, static_cast<eOctant>(i));
-								const auto bound_check = obj_bound.ContainsBy(bound);
-
-								if (bound_check == DirectX::ContainmentType::CONTAINS)
-								{
-									// Expand the node
-									node_children[i]            = std::unique_ptr<Octree>(new Octree{bound});
-									node_children[i]->m_parent_ = node;
-									node_children[i]->Build();
-									node_active_children.set(i);
-									if (node_children[i]->Insert(obj))
-									{
-										found = true;
-										break;
-									}
-								}
-							}
-						}
-
-						if (found)
-						{
-							it = node_value.erase(it);
-						}
-						else
-						{
-							++it;
-						}
-					}
-				}
+		reseedSensors();
+	}
 
-				for (int i = 0; i < octant_count; ++i)
-				{
-					if (node_children[i])
-					{
-						stack.push(node_children[i].get());
-					}
-				}
+	void Octree::ForEach(const ObjectFunc& func) const
+	{
+		for (const EntryIndex entry : m_lookup_ | std::views::values)
+		{
+			func(m_entries_[entry].object);
+		}
+	}
 
-				visited[node] = true;
-			}
+	void Octree::ForEachBounds(const BoundsFunc& func) const
+	{
+		for (const EntryIndex entry : m_lookup_ | std::views::values)
+		{
+			func(m_entries_[entry].id, m_entries_[entry].object, m_entries_[entry].bounds);
 		}
 	}
 
-	void Octree::Clear()
+	void Octree::QueryPairs(const PairFunc& func) const
 	{
-		std::stack<Octree*> stack;
-		stack.push(this);
+		// Loose bounds of the siblings overlap, every node is paired with the nodes that overlap with its
+		// loose bounds. Node with the smaller index owns the pair so each pair is given once.
+		VisitNodes
+				(
+				 [this, &func](const NodeIndex lhs_index)
+				 {
+					 const auto& lhs_entries = m_nodes_[lhs_index].entries;
+
+					 if (lhs_entries.empty())
+					 {
+						 return;
+					 }
+
+					 for (size_t i = 0; i < lhs_entries.size(); ++i)
+					 {
+						 for (size_t j = i + 1; j < lhs_entries.size(); ++j)
+						 {
+							 func(m_entries_[lhs_entries[i]].id, m_entries_[lhs_entries[j]].id);
+						 }
+					 }
+
+					 VisitNodes
+							 (
+							  m_nodes_[lhs_index].loose, [this, &func, &lhs_entries, lhs_index](const NodeIndex rhs_index)
+							  {
+								  if (rhs_index <= lhs_index)
+								  {
+									  return;
+								  }
+
+								  for (const EntryIndex lhs : lhs_entries)
+								  {
+									  for (const EntryIndex rhs : m_nodes_[rhs_index].entries)
+									  {
+										  func(m_entries_[lhs].id, m_entries_[rhs].id);
+									  }
+								  }
+							  }
+							 );
+				 }
+				);
+	}
 
-		while (!stack.empty())
-		{
-			const auto node = stack.top();
-			stack.pop();
+	void Octree::QueryRegion(const BoundingFrustum& region, const ObjectFunc& func) const
+	{
+		queryRegion(region, func);
+	}
 
-			node->m_values_.clear();
+	void Octree::QueryRegion(const BoundingOrientedBox& region, const ObjectFunc& func) const
+	{
+		queryRegion(region, func);
+	}
 
-			for (int i = 0; i < octant_count; ++i)
-			{
-				if (node->m_children_[i])
-				{
-					if (node->m_children_[i]->m_active_children_ == 0 && node->m_values_.size() <= 1)
-					{
-						node->m_children_[i].reset();
-						node->m_active_children_.reset(i);
-					}
-					else
-					{
-						stack.push(node->m_children_[i].get());
-					}
-				}
-			}
-		}
+	void Octree::QueryRegion(const BoundingSphere& region, const ObjectFunc& func) const
+	{
+		queryRegion(region, func);
 	}
 
 	void Octree::Iterate(const Vector3& point, const std::function<bool(const WeakT&)>& func) const
 	{
-		std::queue<const Octree*> q;
-		q.push(this);
+		std::queue<NodeIndex> q;
+		q.push(root_node);
 
 		while (!q.empty())
 		{
-			const auto node = q.front();
+			const Node& node = m_nodes_[q.front()];
 			q.pop();
 
-			const auto& value    = node->m_values_;
-			const auto& children = node->m_children_;
-
-			for (const auto& v : value)
+			for (const EntryIndex entry : node.entries)
 			{
-				if (func(v))
+				if (func(m_entries_[entry].object))
 				{
 					return;
 				}
 			}
 
-			for (const auto& child : children)
+			for (const NodeIndex child : node.children)
 			{
-				if (child && child->Contains(point))
+				if (child != invalid_node &&
+				    m_nodes_[child].loose.Contains(point) == DirectX::ContainmentType::CONTAINS)
 				{
-					q.push(child.get());
+					q.push(child);
 				}
 			}
 		}
@@ -498,50 +400,115 @@ namespace Engine
 
 	std::vector<Octree::WeakT> Octree::Nearest(const Vector3& point, const float distance) const
 	{
-		std::stack<const Octree*> q;
-		std::set<const Octree*>   visited;
-		std::vector<WeakT>        result;
-		const BoundingSphere      search_sphere(point, distance);
+		std::vector<WeakT>   result;
+		const BoundingSphere search_sphere(point, distance);
+
+		VisitNodes
+				(
+				 search_sphere, [this, &search_sphere, &result](const NodeIndex index)
+				 {
+					 for (const EntryIndex entry : m_nodes_[index].entries)
+					 {
+						 if (!m_entries_[entry].bounds.Intersects(search_sphere))
+						 {
+							 continue;
+						 }
+
+						 if (const auto& bounding = m_entries_[entry].bounding;
+							 bounding.Intersects(search_sphere) || bounding.ContainsBy(search_sphere))
+						 {
+							 result.push_back(m_entries_[entry].object);
+						 }
+					 }
+				 }
+				);
 
-		q.push(this);
+		return result;
+	}
 
-		while (!q.empty())
+	frame_vector<Octree::WeakT> Octree::KNearest(const Vector3& point, const size_t k, const float distance) const
+	{
+		frame_vector<WeakT> result;
+
+		if (k == 0)
 		{
-			const auto node = q.top();
+			return result;
+		}
+
+		using node_candidate = std::pair<float, NodeIndex>;
+		using entry_candidate = std::pair<float, EntryIndex>;
+
+		// Nodes from the nearest loose bounds, and the k nearest entries so far with the farthest on the top.
+		std::priority_queue<node_candidate, frame_vector<node_candidate>, std::greater<node_candidate>> queue;
+		frame_vector<entry_candidate>                                                                   heap;
+		heap.reserve(k);
+
+		const float max_distance = FloatCompare(distance, 0.f)
+			                           ? std::numeric_limits<float>::max()
+			                           : distance * distance;
+
+		const auto bound = [&heap, &max_distance, k]()
+		{
+			return heap.size() == k ? heap.front().first : max_distance;
+		};
 
-			const auto& value    = node->m_values_;
-			const auto& children = node->m_children_;
+		queue.emplace(DistanceSquared(m_nodes_[root_node].loose, point), root_node);
 
-			if (visited.contains(node))
+		while (!queue.empty())
+		{
+			const auto [node_distance, index] = queue.top();
+			queue.pop();
+
+			// Remaining nodes are farther than the farthest kept entry.
+			if (node_distance > bound())
 			{
-				q.pop();
+				break;
+			}
+
+			const Node& node = m_nodes_[index];
 
-				for (const auto& v : value)
+			for (const EntryIndex entry : node.entries)
+			{
+				const float entry_distance = DistanceSquared(m_entries_[entry].bounds, point);
+
+				if (entry_distance > bound())
 				{
-					if (const auto& locked = v.lock())
-					{
-						if (const auto& bounding = bounding_getter::value(*locked);
-							bounding.Intersects(search_sphere) || bounding.ContainsBy(search_sphere))
-						{
-							result.push_back(v);
-						}
-					}
+					continue;
 				}
 
-				continue;
-			}
+				if (heap.size() == k)
+				{
+					std::ranges::pop_heap(heap);
+					heap.pop_back();
+				}
 
-			visited.insert(node);
+				heap.emplace_back(entry_distance, entry);
+				std::ranges::push_heap(heap);
+			}
 
-			for (const auto& child : children)
+			for (const NodeIndex child : node.children)
 			{
-				if (child && child->Intersects(search_sphere))
+				if (child == invalid_node)
+				{
+					continue;
+				}
+
+				if (const float child_distance = DistanceSquared(m_nodes_[child].loose, point);
+					child_distance <= bound())
 				{
-					q.push(child.get());
+					queue.emplace(child_distance, child);
 				}
 			}
 		}
 
+		std::ranges::sort_heap(heap);
+		result.reserve(heap.size());
+
+		for (const EntryIndex entry : heap | std::views::values)
+		{
+			result.push_back(m_entries_[entry].object);
+		}
+
 		return result;
 	}
 
@@ -549,59 +516,53 @@ namespace Engine
 		const Vector3& point, const Vector3& direction, const size_t count, const float distance
 	) const
 	{
-		std::stack<const Octree*> q;
-		std::set<const Octree*>   visited;
-		std::vector<WeakT>        result;
-		float                     dist = 0.f;
+		frame_stack<NodeIndex> stack;
+		std::vector<WeakT>     result;
+		float                  dist = 0.f;
 
-		q.push(this);
+		stack.push(root_node);
 
-		while (!q.empty())
+		while (!stack.empty())
 		{
-			const auto node = q.top();
-
-			const auto& value    = node->m_values_;
-			const auto& children = node->m_children_;
+			const Node& node = m_nodes_[stack.top()];
+			stack.pop();
 
-			if (visited.contains(node))
+			for (const EntryIndex entry : node.entries)
 			{
-				q.pop();
+				if (!m_entries_[entry].bounds.Intersects(point, direction, dist))
+				{
+					continue;
+				}
 
-				for (const auto& v : value)
+				// Distance is taken from the bounding, the AABB hits earlier than the object.
+				if (!m_entries_[entry].bounding.TestRay(point, direction, dist))
 				{
-					if (const auto& locked = v.lock())
-					{
-						if (const auto& bounding = bounding_getter::value(*locked);
-							bounding.TestRay(point, direction, dist))
-						{
-							if (!FloatCompare(distance, 0.f))
-							{
-								if (dist > distance)
-								{
-									continue;
-								}
-							}
-
-							result.push_back(v);
-
-							if (count != 0 && result.size() == count)
-							{
-								break;
-							}
-						}
-					}
+					continue;
 				}
 
-				continue;
-			}
+				if (!FloatCompare(distance, 0.f) && dist > distance)
+				{
+					continue;
+				}
 
-			visited.insert(node);
+				result.push_back(m_entries_[entry].object);
 
-			for (const auto& child : children)
+				if (count != 0 && result.size() == count)
+				{
+					return result;
+				}
+			}
+
+			for (const NodeIndex child : node.children)
 			{
-				if (child && child->Intersects(point, direction, dist))
+				if (child != invalid_node && m_nodes_[child].loose.Intersects(point, direction, dist))
 				{
-					q.push(child.get());
+					if (!FloatCompare(distance, 0.f) && dist > distance)
+					{
+						continue;
+					}
+
+					stack.push(child);
 				}
 			}
 		}
@@ -609,192 +570,259 @@ namespace Engine
 		return result;
 	}
 
-	Octree::Octree(const BoundingBox& bounds)
-		: m_parent_(nullptr),
-		  m_b_initialized_(false),
-		  m_life_count_(node_lifespan)
+	void Octree::hitscanPacket(const RayPacket& packet, PacketHits& hits) const
 	{
-		m_bounds_ = bounds;
-	}
+		// Lanes that missed the node are dropped for the subtree.
+		frame_stack<std::pair<NodeIndex, int>> stack;
+		__m128                                 dist;
 
-	Octree::Octree(const BoundingBox& bounds, const std::vector<WeakT>& values)
-		: m_parent_(nullptr),
-		  m_b_initialized_(false),
-		  m_life_count_(node_lifespan)
-	{
-		m_bounds_ = bounds;
-		m_values_ = values;
-	}
-
-	void Octree::Build()
-	{
-		std::stack<Octree*> stack;
-		stack.push(this);
+		stack.emplace(root_node, packet.lane_mask);
 
 		while (!stack.empty())
 		{
-			const auto node = stack.top();
+			const auto [index, mask] = stack.top();
 			stack.pop();
 
-			auto&      node_value           = node->m_values_;
-			auto&      node_children        = node->m_children_;
-			auto&      node_active_children = node->m_active_children_;
-			auto&      node_active_flag     = node->m_b_initialized_;
-			const auto node_extent          = node->Extent();
-			const auto node_center          = node->WorldCenter();
-			const auto extent_scale         = node->Extent() * 2.f;
-
-			node_active_flag = true;
-
-			if (node_value.size() <= 1 && root() != this)
-			{
-				continue; // Leaf node
-			}
+			const Node& node = m_nodes_[index];
 
-			// Node is bigger than the max map size
-			if (extent_scale.x < static_cast<float>(g_max_map_size) &&
-			    extent_scale.y < static_cast<float>(g_max_map_size) &&
-			    extent_scale.z < static_cast<float>(g_max_map_size))
+			for (const EntryIndex entry : node.entries)
 			{
-				continue;
+				if (const int hit = IntersectPacket(m_entries_[entry].bounds, packet, mask, dist))
+				{
+					AppendHits(hit, dist, m_entries_[entry].object, hits);
+				}
 			}
 
-			// Split the node into 8 octants, if it is needed, and distribute the objects
-			const std::vector<BoundingBox>               octants = GetBounds(node_extent, node_center);
-			std::array<std::vector<WeakT>, octant_count> octant_values;
-
-			for (int i = 0; i < octant_count; ++i)
+			for (const NodeIndex child : node.children)
 			{
-				for (auto it = node_value.begin(); it != node_value.end();)
+				if (child == invalid_node)
 				{
-					if (bounding_getter::value(*it->lock()).ContainsBy(octants[i]) == DirectX::CONTAINS)
-					{
-						octant_values[i].push_back(*it);
-						it = node_value.erase(it);
-					}
-					else
-					{
-						++it;
-					}
+					continue;
 				}
-			}
 
-			for (int i = 0; i < octant_count; ++i)
-			{
-				if (!octant_values[i].empty())
+				if (const int hit = IntersectPacket(m_nodes_[child].loose, packet, mask, dist))
 				{
-					node_children[i]            = std::unique_ptr<Octree>(new Octree{octants[i], octant_values[i]});
-					node_children[i]->m_parent_ = node;
-					node_children[i]->Build();
-					node_active_children.set(i);
-					stack.push(node_children[i].get());
+					stack.emplace(child, hit);
 				}
 			}
 		}
 	}
 
-	void Octree::Panic()
+	void Octree::relocate(const EntryIndex entry)
 	{
-		if (root() != this)
+		const BoundingBox& bounds = m_entries_[entry].bounds;
+		NodeIndex          node   = m_entries_[entry].node;
+
+		// Bubble up until the cell can hold the object, root keeps the object that is out of the map.
+		while (node != root_node && !fits(node, bounds))
 		{
-			throw std::logic_error("Cannot force update from child node.");
+			node = m_nodes_[node].parent;
 		}
 
-		// Keep in mind that this is rebuilding the whole tree from root node.
-		m_b_initialized_ = false;
+		// And down to the smallest cell.
+		if (const NodeIndex target = locate(bounds, node); target != m_entries_[entry].node)
+		{
+			detach(entry);
+			attach(entry, target);
+		}
+	}
 
-		std::stack<Octree*> stack;
-		stack.push(root());
+	Octree::NodeIndex Octree::locate(const BoundingBox& bounds, const NodeIndex from)
+	{
+		const Vector3 center = bounds.Center;
+		const float   radius = std::max({bounds.Extents.x, bounds.Extents.y, bounds.Extents.z});
 
-		// Scan the whole tree and collect all objects
-		while (!stack.empty())
+		// Does not fit even in the given node, keep it there.
+		if (!fits(from, bounds))
 		{
-			const auto node = stack.top();
-			stack.pop();
+			return from;
+		}
 
-			for (const auto& obj : node->m_values_)
+		NodeIndex index = from;
+
+		while (m_nodes_[index].depth < max_depth)
+		{
+			const Vector3 node_center = m_nodes_[index].bounds.Center;
+			const float   half        = m_nodes_[index].bounds.Extents.x * 0.5f;
+
+			// Object fits in the loose bounds of the child only if it is not larger than the child cell.
+			if (radius > half)
 			{
-				m_insertion_queue_.push(obj);
+				break;
 			}
 
-			for (int i = 0; i < octant_count; ++i)
-			{
-				if (node->m_children_[i])
-				{
-					const auto& child = node->m_children_[i];
+			const auto region = static_cast<eOctant>
+					(
+					 (center.z < node_center.z) |
+					 ((center.x >= node_center.x) << 1) |
+					 ((center.y < node_center.y) << 2)
+					);
 
-					if (child->m_active_children_ == 0 && child->m_values_.size() <= 1)
-					{
-						if (child->m_values_.size() == 1)
-						{
-							m_insertion_queue_.push(child->m_values_[0]);
-						}
+			NodeIndex child = m_nodes_[index].children[static_cast<size_t>(region)];
 
-						node->m_children_[i].reset();
-						node->m_active_children_.reset(i);
-					}
-					else
-					{
-						stack.push(node->m_children_[i].get());
-					}
-				}
+			if (child == invalid_node)
+			{
+				child = allocateNode(index, region);
 			}
+
+			index = child;
+		}
+
+		return index;
+	}
+
+	Octree::NodeIndex Octree::allocateNode(const NodeIndex parent, const eOctant region)
+	{
+		NodeIndex index;
+
+		if (!m_free_nodes_.empty())
+		{
+			index = m_free_nodes_.back();
+			m_free_nodes_.pop_back();
 		}
+		else
+		{
+			index = static_cast<NodeIndex>(m_nodes_.size());
+			m_nodes_.emplace_back();
+		}
+
+		// Pool can be grown above, reference the parent after the allocation.
+		const Node& parent_node = m_nodes_[parent];
+		Node&       node        = m_nodes_[index];
+
+		node.bounds     = GetBound(parent_node.bounds.Extents, parent_node.bounds.Center, region);
+		node.loose      = GetLoose(node.bounds);
+		node.parent     = parent;
+		node.depth      = parent_node.depth + 1;
+		node.life_count = node_lifespan;
+		node.alive      = true;
+		node.retired    = false;
+		node.entries.clear();
+		node.children.fill(invalid_node);
 
-		m_values_.clear();
+		m_nodes_[parent].children[static_cast<size_t>(region)] = index;
 
-		// Rebuild the tree
-		UpdateInternal();
+		return index;
 	}
 
-	void Octree::UpdateInternal()
+	void Octree::freeNode(const NodeIndex index)
 	{
-		// Initialize the newly created tree, or rebuild the whole tree
-		if (!m_b_initialized_)
+		Node&           node   = m_nodes_[index];
+		const NodeIndex parent = node.parent;
+
+		std::ranges::replace(m_nodes_[parent].children, index, invalid_node);
+
+		node.alive  = false;
+		node.parent = invalid_node;
+		node.entries.clear();
+		m_free_nodes_.push_back(index);
+
+		// Parent can be an empty leaf now.
+		if (m_nodes_[parent].entries.empty())
 		{
-			while (!m_insertion_queue_.empty())
-			{
-				if (auto obj = m_insertion_queue_.front().lock())
-				{
-					m_values_.push_back(obj);
-				}
+			retire(parent);
+		}
+	}
 
-				m_insertion_queue_.pop();
-			}
+	void Octree::attach(const EntryIndex entry, const NodeIndex node)
+	{
+		auto& entries = m_nodes_[node].entries;
+
+		m_entries_[entry].node = node;
+		m_entries_[entry].slot = static_cast<UINT>(entries.size());
+		entries.push_back(entry);
+	}
 
-			Build();
+	void Octree::detach(const EntryIndex entry)
+	{
+		const Entry& target  = m_entries_[entry];
+		auto&        entries = m_nodes_[target.node].entries;
+
+		// Swap with the last one to keep the list compact.
+		const EntryIndex last = entries.back();
+		entries[target.slot]  = last;
+		m_entries_[last].slot = target.slot;
+		entries.pop_back();
+
+		if (entries.empty())
+		{
+			retire(target.node);
 		}
-		else
+
+		m_entries_[entry].node = invalid_node;
+	}
+
+	void Octree::release(const EntryIndex entry)
+	{
+		detach(entry);
+		m_lookup_.erase(m_entries_[entry].id);
+
+		m_entries_[entry] = {};
+		m_free_entries_.push_back(entry);
+	}
+
+	void Octree::retire(const NodeIndex index)
+	{
+		Node& node = m_nodes_[index];
+
+		if (index == root_node || node.retired)
 		{
-			// Resolve the insertion queue and clear dirty flag
-			while (!m_insertion_queue_.empty())
+			return;
+		}
+
+		node.retired    = true;
+		node.life_count = node_lifespan;
+		m_empty_nodes_.push_back(index);
+	}
+
+	void Octree::collect()
+	{
+		for (size_t i = 0; i < m_empty_nodes_.size();)
+		{
+			const NodeIndex index = m_empty_nodes_[i];
+			Node&           node  = m_nodes_[index];
+
+			// Node is used again, or it will be retired again when its children are freed.
+			if (!node.alive || !node.entries.empty() || !leaf(index))
 			{
-				if (auto obj = m_insertion_queue_.front().lock())
-				{
-					m_insertion_queue_.pop();
-					Insert(obj);
-				}
+				node.retired      = false;
+				m_empty_nodes_[i] = m_empty_nodes_.back();
+				m_empty_nodes_.pop_back();
+				continue;
+			}
+
+			if (--node.life_count >= 0)
+			{
+				++i;
+				continue;
 			}
+
+			node.retired      = false;
+			m_empty_nodes_[i] = m_empty_nodes_.back();
+			m_empty_nodes_.pop_back();
+
+			// Parent is appended to the list if it becomes an empty leaf.
+			freeNode(index);
 		}
 	}
 
-	std::vector<BoundingBox> __vectorcall Octree::GetBounds(
-		const Vector3& extent, const Vector3& center
-	)
+	bool Octree::leaf(const NodeIndex index) const
 	{
-		BoundingBox tlfb, trfb, blfb, brfb, tlbb, trbb, blbb, brbb;
-
-		BoundingBox::CreateFromPoints(tlfb, center + (extent * tlf), center);
-		BoundingBox::CreateFromPoints(trfb, center + (extent * trf), center);
-		BoundingBox::CreateFromPoints(blfb, center + (extent * blf), center);
-		BoundingBox::CreateFromPoints(brfb, center + (extent * brf), center);
+		return std::ranges::all_of
+				(
+				 m_nodes_[index].children, [](const NodeIndex child)
+				 {
+					 return child == invalid_node;
+				 }
+				);
+	}
 
-		BoundingBox::CreateFromPoints(tlbb, center, center + (extent * tlb));
-		BoundingBox::CreateFromPoints(trbb, center, center + (extent * trb));
-		BoundingBox::CreateFromPoints(blbb, center, center + (extent * blb));
-		BoundingBox::CreateFromPoints(brbb, center, center + (extent * brb));
+	bool Octree::fits(const NodeIndex index, const BoundingBox& bounds) const
+	{
+		const BoundingBox& cell   = m_nodes_[index].bounds;
+		const float        radius = std::max({bounds.Extents.x, bounds.Extents.y, bounds.Extents.z});
 
-		return {tlfb, trfb, blfb, brfb, tlbb, trbb, blbb, brbb};
+		return cell.Contains(bounds.Center) != DirectX::ContainmentType::DISJOINT && radius <= cell.Extents.x;
 	}
 
 	BoundingBox __vectorcall Octree::GetBound(
@@ -836,53 +864,132 @@ namespace Engine
 		return bound;
 	}
 
-	Octree* Octree::root()
+	BoundingBox __vectorcall Octree::GetLoose(const BoundingBox& bounds)
 	{
-		return m_parent_ ? m_parent_->root() : this;
+		return BoundingBox(bounds.Center, Vector3(bounds.Extents) * looseness);
 	}
 
-	Octree* Octree::parent() const
+	UINT64 __vectorcall Octree::Encode(const Vector3& center)
 	{
-		return m_parent_ ? m_parent_ : nullptr;
-	}
+		constexpr UINT64 cells     = 1ull << max_depth;
+		constexpr float  cell_size = static_cast<float>(g_max_map_size) / cells;
 
-	bool Octree::ready() const
-	{
-		return m_b_initialized_ && !dirty();
-	}
+		const auto quantize = [](const float v)
+		{
+			const float cell = std::floor((v + static_cast<float>(g_max_map_size) / 2) / cell_size);
+			return static_cast<UINT64>(std::clamp(cell, 0.f, static_cast<float>(cells - 1)));
+		};
 
-	bool Octree::dirty() const
-	{
-		return !m_insertion_queue_.empty();
-	}
+		const UINT64 x = quantize(center.x);
+		const UINT64 y = quantize(center.y);
+		const UINT64 z = quantize(center.z);
 
-	bool Octree::garbage() const
-	{
-		return m_life_count_ < 0;
-	}
+		UINT64 code = 0;
 
-	bool Octree::empty() const
-	{
-		return m_values_.empty() && m_active_children_.none();
-	}
+		for (UINT level = 0; level < max_depth; ++level)
+		{
+			const UINT bit = max_depth - 1 - level;
 
-	Vector3 Octree::MaxWorldPoint() const
-	{
-		return Vector3(m_bounds_.Center) + m_bounds_.Extents;
-	}
+			// Back, right and bottom are set, as in the locate.
+			const UINT64 octant = (~(z >> bit) & 1) | (((x >> bit) & 1) << 1) | ((~(y >> bit) & 1) << 2);
 
-	Vector3 Octree::MinWorldPoint() const
-	{
-		return Vector3(m_bounds_.Center) - m_bounds_.Extents;
+			code = (code << 3) | octant;
+		}
+
+		return code;
 	}
 
-	Vector3 Octree::Extent() const
+	UINT __vectorcall Octree::GetFitDepth(const BoundingBox& bounds)
 	{
-		return m_bounds_.Extents;
+		const float radius = std::max({bounds.Extents.x, bounds.Extents.y, bounds.Extents.z});
+		float       extent = map_size_vec.x;
+		UINT        depth  = 0;
+
+		// Larger than the map, stays in the root.
+		if (radius > extent)
+		{
+			return 0;
+		}
+
+		while (depth < max_depth && radius <= extent * 0.5f)
+		{
+			extent *= 0.5f;
+			++depth;
+		}
+
+		return depth;
 	}
 
-	Vector3 Octree::WorldCenter() const
+	void Octree::RadixSort(std::vector<MortonKey>& keys)
 	{
-		return m_bounds_.Center;
+		constexpr size_t radix_bits   = 8;
+		constexpr size_t bucket_count = 1 << radix_bits;
+		constexpr size_t key_bits     = max_depth * 3;
+		constexpr size_t min_chunk    = 1024;
+
+		using histogram = std::array<size_t, bucket_count>;
+
+		const size_t chunk_count = std::clamp
+				(
+				 keys.size() / min_chunk, static_cast<size_t>(1),
+				 static_cast<size_t>(tbb::this_task_arena::max_concurrency())
+				);
+		const size_t chunk_size = (keys.size() + chunk_count - 1) / chunk_count;
+
+		std::vector<MortonKey> buffer(keys.size());
+		std::vector<histogram> offsets(chunk_count);
+
+		for (size_t shift = 0; shift < key_bits; shift += radix_bits)
+		{
+			const auto digit = [shift](const MortonKey& key)
+			{
+				return (key.code >> shift) & (bucket_count - 1);
+			};
+
+			tbb::parallel_for
+					(
+					 static_cast<size_t>(0), chunk_count, [&](const size_t chunk)
+					 {
+						 const size_t begin = chunk * chunk_size;
+						 const size_t end   = std::min(begin + chunk_size, keys.size());
+
+						 offsets[chunk].fill(0);
+
+						 for (size_t i = begin; i < end; ++i)
+						 {
+							 ++offsets[chunk][digit(keys[i])];
+						 }
+					 }
+					);
+
+			// Exclusive prefix in the digit order then the chunk order, which keeps the sort stable.
+			size_t sum = 0;
+
+			for (size_t bucket = 0; bucket < bucket_count; ++bucket)
+			{
+				for (histogram& chunk_offsets : offsets)
+				{
+					const size_t count    = chunk_offsets[bucket];
+					chunk_offsets[bucket] = sum;
+					sum += count;
+				}
+			}
+
+			tbb::parallel_for
+					(
+					 static_cast<size_t>(0), chunk_count, [&](const size_t chunk)
+					 {
+						 const size_t begin = chunk * chunk_size;
+						 const size_t end   = std::min(begin + chunk_size, keys.size());
+
+						 for (size_t i = begin; i < end; ++i)
+						 {
+							 buffer[offsets[chunk][digit(keys[i])]++] = keys[i];
+						 }
+					 }
+					);
+
+			keys.swap(buffer);
+		}
 	}
 }
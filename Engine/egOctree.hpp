@@ -1,21 +1,58 @@
 #pragma once
-#include <bitset>
-#include <stack>
+#include <array>
+#include <bit>
+#include <unordered_map>
 #include <vector>
-#include <boost/smart_ptr/weak_ptr.hpp>
-#include "egGenericBounding.hpp"
+#include "egFrameArena.hpp"
+#include "egSpatialIndex.hpp"
 
 namespace Engine
 {
-	// todo: generic octree
-	class Octree
+	// Loose octree, nodes are stored in one pool and addressed by the index. Node bounds are enlarged by
+	// the looseness so that the object is placed by its center and never straddles the children.
+	class Octree final : public SpatialIndex
 	{
+	public:
+		using NodeIndex = UINT;
+		using EntryIndex = UINT;
+
+		constexpr static size_t     octant_count  = 8;
+		constexpr static NodeIndex  root_node     = 0;
+		constexpr static NodeIndex  invalid_node  = std::numeric_limits<NodeIndex>::max();
+		constexpr static EntryIndex invalid_entry = std::numeric_limits<EntryIndex>::max();
+
+		// Object in the tree, bounds are cached at the insertion and the update. Traversal tests the AABB, and
+		// the queries confirm the hits with the bounding of the object.
+		struct Entry
+		{
+			GlobalEntityID           id     = g_invalid_id;
+			BoundingBox              bounds = {};
+			Physics::GenericBounding bounding;
+			NodeIndex                node = invalid_node;
+			// Position in the entry list of the node.
+			UINT  slot = 0;
+			WeakT object;
+		};
+
+		struct Node
+		{
+			BoundingBox                         bounds = {};
+			BoundingBox                         loose  = {};
+			NodeIndex                           parent = invalid_node;
+			std::array<NodeIndex, octant_count> children;
+			std::vector<EntryIndex>             entries;
+			UINT                                depth      = 0;
+			int                                 life_count = 0;
+			bool                                alive      = false;
+			// Empty leaf which is waiting for the lifespan to be freed.
+			bool retired = false;
+		};
+
 	private:
-		using WeakT = boost::weak_ptr<Abstract::ObjectBase>;
-		constexpr static size_t   octant_count   = 8;
 		constexpr static int      node_lifespan  = 10;
-		constexpr static unsigned retry_exhaust  = 100;
 		constexpr static int      smallest_scale = 2;
+		constexpr static float    looseness      = 2.f;
+		constexpr static UINT     max_depth      = std::bit_width(g_max_map_size / smallest_scale) - 1;
 		constexpr static Vector3  map_size_vec   = Vector3{
 			static_cast<float>(g_max_map_size) / 2, static_cast<float>(g_max_map_size) / 2,
 			static_cast<float>(g_max_map_size) / 2
@@ -48,86 +85,212 @@ namespace Engine
 
 	public:
 		Octree();
-		Octree(const Octree& other);
 
-		const std::vector<WeakT>&    Read() const;
-		std::array<const Octree*, 8> Next() const;
-		bool                         Contains(const Vector3& point) const;
+		eSpatialIndexType GetType() const override;
+		size_t            GetCount() const override;
 
-		// Checks if the given point or bounds intersects with the node.
+		const Node&  GetNode(NodeIndex index) const;
+		const Entry& GetEntry(EntryIndex index) const;
+		size_t       GetNodeCount() const;
+		bool         Contains(const Vector3& point) const;
+
+		// Checks if the given point or bounds intersects with the tree.
 		template <typename T>
 		bool Intersects(const T& point_or_bounds) const
 		{
-			return m_bounds_.Intersects(point_or_bounds);
+			return m_nodes_[root_node].loose.Intersects(point_or_bounds);
 		}
 
-		// Check if the given ray intersects with the node.
+		// Check if the given ray intersects with the tree.
 		bool Intersects(const Vector3& point, const Vector3& dir, float& distance) const
 		{
-			return m_bounds_.Intersects(point, dir, distance);
+			return m_nodes_[root_node].loose.Intersects(point, dir, distance);
 		}
 
 		template <typename T>
 		bool Contains(const T& point_or_bounds) const
 		{
-			return m_bounds_.Contains(point_or_bounds) == DirectX::ContainmentType::CONTAINS;
+			return m_nodes_[root_node].loose.Contains(point_or_bounds) == DirectX::ContainmentType::CONTAINS;
 		}
 
-		// Gets the distance between node bounding box and the given point.
-		float              Distance(const Vector3& point) const;
-		UINT               ActiveChildren() const;
-		bool               Insert(const WeakT& obj);
-		void               Remove(const WeakT& obj);
-		void               Update();
-		void               Clear();
-		void               Iterate(const Vector3& point, const std::function<bool(const WeakT&)>& func) const;
-		std::vector<WeakT> Nearest(const Vector3& point, float distance) const;
+		// Visits every live node in depth-first order.
+		template <typename Func>
+		void VisitNodes(Func&& func) const
+		{
+			frame_stack<NodeIndex> stack;
+			stack.push(root_node);
+
+			while (!stack.empty())
+			{
+				const NodeIndex index = stack.top();
+				stack.pop();
+
+				func(index);
+
+				for (const NodeIndex child : m_nodes_[index].children)
+				{
+					if (child != invalid_node)
+					{
+						stack.push(child);
+					}
+				}
+			}
+		}
+
+		// Visits the live nodes which the loose bounds intersect with the given bounds. (root is always visited)
+		template <typename T, typename Func>
+		void VisitNodes(const T& bounds, Func&& func) const
+		{
+			frame_stack<NodeIndex> stack;
+			stack.push(root_node);
+
+			while (!stack.empty())
+			{
+				const NodeIndex index = stack.top();
+				stack.pop();
+
+				const Node& node = m_nodes_[index];
+
+				// Root also holds the objects that are out of the map.
+				if (index != root_node && !node.loose.Intersects(bounds))
+				{
+					continue;
+				}
+
+				func(index);
+
+				for (const NodeIndex child : node.children)
+				{
+					if (child != invalid_node)
+					{
+						stack.push(child);
+					}
+				}
+			}
+		}
+
+		// Gets the distance between tree bounding box and the given point.
+		float Distance(const Vector3& point) const;
+		UINT  ActiveChildren() const;
+
+		bool Insert(const WeakT& obj) override;
+		void Remove(const WeakT& obj) override;
+		// Relocates the notified objects and frees the empty leaves which are expired.
+		void Update() override;
+		void Clear() override;
+		// Bulk build, the objects are sorted by the morton code of the center and the nodes are emitted
+		// top-down in the sorted order.
+		void Build(std::span<const WeakT> objects) override;
+
+		void ForEach(const ObjectFunc& func) const override;
+		void ForEachBounds(const BoundsFunc& func) const override;
+		// Objects in the same node, and the objects in the nodes that the loose bounds overlap.
+		void QueryPairs(const PairFunc& func) const override;
+
+		void QueryRegion(const BoundingFrustum& region, const ObjectFunc& func) const override;
+		void QueryRegion(const BoundingOrientedBox& region, const ObjectFunc& func) const override;
+		void QueryRegion(const BoundingSphere& region, const ObjectFunc& func) const override;
+
+		void Iterate(const Vector3& point, const std::function<bool(const WeakT&)>& func) const override;
+		std::vector<WeakT>  Nearest(const Vector3& point, float distance) const override;
+		frame_vector<WeakT> KNearest(const Vector3& point, size_t k, float distance = 0.f) const override;
 		std::vector<WeakT> Hitscan(
 			const Vector3& point, const Vector3& direction, size_t count = 0, float distance = 0.f
-		) const;
+		) const override;
 
 	private:
-		explicit Octree(const BoundingBox& bounds);
-		explicit Octree(const BoundingBox& bounds, const std::vector<WeakT>& values);
+		void hitscanPacket(const RayPacket& packet, PacketHits& hits) const override;
 
-		// Initialize a node
-		void Build();
-		// Resolving panic status, rebuilds the whole tree.
-		void Panic();
-		// Resolving dirty status or rebuilding.
-		void UpdateInternal();
+		template <typename T>
+		void queryRegion(const T& region, const ObjectFunc& func) const
+		{
+			// Node and whether its loose bounds is inside the region. Entries cannot exceed the loose bounds, so
+			// the subtree of the inside node is taken as is. Root is never taken as is, it holds the objects
+			// out of the map.
+			frame_stack<std::pair<NodeIndex, bool>> stack;
+			stack.emplace(root_node, false);
 
-		// Utility function for getting the octant bounds.
-		static std::vector<BoundingBox> __vectorcall GetBounds(const Vector3& extent, const Vector3& center);
-		static BoundingBox __vectorcall GetBound(const Vector3& extent, const Vector3& center, eOctant region);
+			while (!stack.empty())
+			{
+				const auto [index, inside] = stack.top();
+				stack.pop();
+
+				const Node& node = m_nodes_[index];
+
+				for (const EntryIndex entry : node.entries)
+				{
+					if (inside || region.Intersects(m_entries_[entry].bounds))
+					{
+						func(m_entries_[entry].object);
+					}
+				}
+
+				for (const NodeIndex child : node.children)
+				{
+					if (child == invalid_node)
+					{
+						continue;
+					}
+
+					if (inside)
+					{
+						stack.emplace(child, true);
+						continue;
+					}
 
-		Octree* root();
-		Octree* parent() const;
-		bool    ready() const;
-		bool    dirty() const;
-		bool    garbage() const;
-		bool    empty() const;
+					if (const auto containment = region.Contains(m_nodes_[child].loose);
+						containment != DirectX::DISJOINT)
+					{
+						stack.emplace(child, containment == DirectX::CONTAINS);
+					}
+				}
+			}
+		}
 
-		// The max points of the bounding box in world space.
-		Vector3 MaxWorldPoint() const;
-		// The min points of the bounding box in world space.
-		Vector3 MinWorldPoint() const;
+		// Object of the bulk build, sorted by the code.
+		struct MortonKey
+		{
+			UINT64 code;
+			UINT   index;
+			UINT   depth;
+		};
 
-		// The size of the bounding box in world space in half.
-		Vector3 Extent() const;
-		// The center of the bounding box in world space.
-		Vector3 WorldCenter() const;
+		static_assert(max_depth * 3 <= sizeof(UINT64) * 8, "Morton code does not fit in the key");
 
-		Octree*                                           m_parent_;
-		std::array<std::unique_ptr<Octree>, octant_count> m_children_;
-		std::bitset<octant_count>                         m_active_children_;
-		std::vector<WeakT>                                m_values_;
+		// Moves the entry to the node that fits its cached bounds, walking up and down from the current node.
+		void      relocate(EntryIndex entry);
+		// Finds the smallest node under the given node that can hold the bounds, creates the nodes along the
+		// path if needed.
+		NodeIndex locate(const BoundingBox& bounds, NodeIndex from);
+		NodeIndex allocateNode(NodeIndex parent, eOctant region);
+		void      freeNode(NodeIndex index);
+		void      attach(EntryIndex entry, NodeIndex node);
+		void      detach(EntryIndex entry);
+		void      release(EntryIndex entry);
+		// Marks the node as an empty leaf candidate.
+		void      retire(NodeIndex index);
+		// Frees the retired nodes which have been empty longer than the lifespan.
+		void      collect();
+		bool      leaf(NodeIndex index) const;
+		// Checks if the center is in the cell and the bounds is not larger than the cell.
+		bool      fits(NodeIndex index, const BoundingBox& bounds) const;
 
-		BoundingBox m_bounds_;
+		// Utility function for getting the octant bounds.
+		static BoundingBox __vectorcall GetBound(const Vector3& extent, const Vector3& center, eOctant region);
+		static BoundingBox __vectorcall GetLoose(const BoundingBox& bounds);
+		// Octant path of the center from the root to the deepest level, 3 bits per level in the eOctant layout.
+		static UINT64 __vectorcall Encode(const Vector3& center);
+		// Deepest level of the cell that the bounds is not larger than, same as the locate.
+		static UINT __vectorcall   GetFitDepth(const BoundingBox& bounds);
+		// Parallel LSD radix sort by the code, stable.
+		static void RadixSort(std::vector<MortonKey>& keys);
 
-		std::queue<WeakT> m_insertion_queue_;
-		bool              m_b_initialized_;
+		std::vector<Node>       m_nodes_;
+		std::vector<NodeIndex>  m_free_nodes_;
+		std::vector<Entry>      m_entries_;
+		std::vector<EntryIndex> m_free_entries_;
+		std::vector<NodeIndex>  m_empty_nodes_;
 
-		int m_life_count_;
+		std::unordered_map<GlobalEntityID, EntryIndex> m_lookup_;
 	};
 }
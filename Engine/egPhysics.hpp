@@ -54,6 +54,24 @@ namespace Engine::Physics
 		}
 	};
 
+	struct ConvexHull;
+
+	// World space vertices in the structure of arrays for the support mapping. Arrays are padded to the multiple of
+	// 8 with the last vertex, the scan runs without the tail.
+	struct WorldVertexCollection
+	{
+		std::vector<float> x;
+		std::vector<float> y;
+		std::vector<float> z;
+		size_t             count = 0;
+
+		// Hull of the vertices if they are transformed from the hull, the support mapping climbs its adjacency.
+		boost::shared_ptr<const ConvexHull> hull;
+
+		void __vectorcall Transform(const VertexCollection& vertices, const Matrix& world);
+		void __vectorcall Transform(const boost::shared_ptr<const ConvexHull>& convex, const Matrix& world);
+	};
+
 	extern Vector3 __vectorcall EvalGravity(float invMass, float dt);
 
 	__forceinline Vector3 __vectorcall EvalT1PositionDelta(
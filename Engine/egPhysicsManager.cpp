@@ -103,15 +103,16 @@ namespace Engine::Manager::Physics
 			scene->GetPhysXScene()->fetchResults(true);
 			UpdateFromPhysX();
 #else
-			const auto& rbs = scene->GetCachedComponents<Components::Rigidbody>();
+			const auto& rbs = scene->GetLockedComponents<Components::Rigidbody>();
 
-			for (const auto rb : rbs)
-			{
-				if (const auto locked = rb.lock())
-				{
-					UpdateObject(locked->GetSharedPtr<Components::Rigidbody>().get(), dt);
-				}
-			}
+			// Integration of each body is independent.
+			GetTaskScheduler().ParallelFor
+					(
+					 rbs.size(), [&rbs, dt](const size_t i)
+					 {
+						 UpdateObject(rbs[i].get(), dt);
+					 }, g_rigidbody_parallel_grain
+					);
 #endif
 		}
 	}
@@ -268,4 +269,15 @@ namespace Engine::Manager::Physics
 		}
 	}
 #endif
+
+	ManagerAccess PhysicsManager::GetAccess(const eManagerPhase phase) const
+	{
+		switch (phase)
+		{
+		case MANAGER_PHASE_FIXED_UPDATE:
+			return g_manager_access_exclusive;
+		default:
+			return g_manager_access_none;
+		}
+	}
 } // namespace Engine::Manager::Physics
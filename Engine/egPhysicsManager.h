@@ -23,6 +23,7 @@ namespace Engine::Manager::Physics
 			: Singleton() {}
 
 		void Initialize() override;
+		ManagerAccess GetAccess(eManagerPhase phase) const override;
 		void PreUpdate(const float& dt) override;
 		void Update(const float& dt) override;
 		void PreRender(const float& dt) override;
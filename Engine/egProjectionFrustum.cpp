@@ -14,6 +14,8 @@ namespace Engine::Manager
 
 	void ProjectionFrustum::PreRender(const float& dt)
 	{
+		m_visible_.clear();
+
 		if (const auto scene = GetSceneManager().GetActiveScene().lock())
 		{
 			const auto camera_layer = scene->GetGameObjects(LAYER_CAMERA);
@@ -40,6 +42,17 @@ namespace Engine::Manager
 
 				BoundingSphere::CreateFromFrustum(m_sphere, m_frustum);
 			}
+
+			scene->GetObjectTree().QueryRegion
+					(
+					 m_frustum, [this](const WeakObjectBase& obj)
+					 {
+						 if (const auto locked = obj.lock())
+						 {
+							 m_visible_.insert(locked->GetID());
+						 }
+					 }
+					);
 		}
 	}
 
@@ -49,33 +62,56 @@ namespace Engine::Manager
 
 	bool ProjectionFrustum::CheckRender(const WeakObjectBase& object) const
 	{
-		if (const auto tr =
-				object.lock()->GetComponent<Components::Transform>().lock())
+		if (const auto locked = object.lock())
 		{
-			BoundingOrientedBox box{
-				tr->GetWorldPosition(),
-				tr->GetWorldScale() * 0.5f,
-				tr->GetWorldRotation()
-			};
-
-			try
+			if (const auto tr = locked->GetComponent<Components::Transform>().lock())
 			{
-				const auto check_plane  = m_frustum.Contains(box);
-				const auto check_sphere = m_sphere.Contains(box);
-
-				return check_plane != DirectX::DISJOINT ||
-				       check_sphere != DirectX::DISJOINT;
-			}
-			catch (const std::exception& e)
-			{
-				GetDebugger().Log(e.what());
-				return false;
+				return CheckRender
+						(
+						 locked->GetID(),
+						 BoundingOrientedBox{
+							 tr->GetWorldPosition(),
+							 tr->GetWorldScale() * 0.5f,
+							 tr->GetWorldRotation()
+						 }
+						);
 			}
+
+			return m_visible_.contains(locked->GetID());
 		}
 
 		return false;
 	}
 
+	bool ProjectionFrustum::CheckRender(const GlobalEntityID id, const BoundingOrientedBox& bounds) const
+	{
+		if (m_visible_.contains(id))
+		{
+			return true;
+		}
+
+		// Index does not hold the objects outside of the map, and its bounds are from the collider rather
+		// than the mesh.
+		return CheckRender(bounds);
+	}
+
+	bool ProjectionFrustum::CheckRender(const BoundingOrientedBox& box) const
+	{
+		try
+		{
+			const auto check_plane  = m_frustum.Contains(box);
+			const auto check_sphere = m_sphere.Contains(box);
+
+			return check_plane != DirectX::DISJOINT ||
+			       check_sphere != DirectX::DISJOINT;
+		}
+		catch (const std::exception& e)
+		{
+			GetDebugger().Log(e.what());
+			return false;
+		}
+	}
+
 	BoundingFrustum ProjectionFrustum::GetFrustum() const
 	{
 		return m_frustum;
@@ -84,4 +120,15 @@ namespace Engine::Manager
 	void ProjectionFrustum::FixedUpdate(const float& dt) {}
 
 	void ProjectionFrustum::PostUpdate(const float& dt) {}
+
+	ManagerAccess ProjectionFrustum::GetAccess(const eManagerPhase phase) const
+	{
+		switch (phase)
+		{
+		case MANAGER_PHASE_PRE_RENDER:
+			return {MANAGER_ACCESS_SCENE | MANAGER_ACCESS_TRANSFORM, MANAGER_ACCESS_FRUSTUM};
+		default:
+			return g_manager_access_none;
+		}
+	}
 } // namespace Engine::Manager
@@ -1,4 +1,5 @@
 #pragma once
+#include <unordered_set>
 #include "egCommon.hpp"
 #include "egDXCommon.h"
 #include "egManager.hpp"
@@ -12,6 +13,7 @@ namespace Engine::Manager
 			: Singleton() {}
 
 		void Initialize() override;
+		ManagerAccess GetAccess(eManagerPhase phase) const override;
 		void Update(const float& dt) override;
 		void PreUpdate(const float& dt) override;
 		void PreRender(const float& dt) override;
@@ -20,7 +22,12 @@ namespace Engine::Manager
 		void FixedUpdate(const float& dt) override;
 		void PostUpdate(const float& dt) override;
 
+		// Checks if the object was in the frustum at the pre-render, objects that the spatial index did not find
+		// are tested with their transform.
 		bool CheckRender(const WeakObjectBase& object) const;
+		// Same as above, objects that the spatial index did not find are tested with the given bounds.
+		bool CheckRender(GlobalEntityID id, const BoundingOrientedBox& bounds) const;
+		bool CheckRender(const BoundingOrientedBox& box) const;
 
 		BoundingFrustum GetFrustum() const;
 
@@ -30,6 +37,9 @@ namespace Engine::Manager
 
 		BoundingFrustum m_frustum;
 		BoundingSphere  m_sphere;
+
+		// Objects which the spatial index found in the frustum, rebuilt at every pre-render.
+		std::unordered_set<GlobalEntityID> m_visible_;
 	};
 } // namespace Engine::Manager
 
@@ -137,7 +137,7 @@ namespace Engine::Manager::Graphics
 			UINT64 total_item_count = 0;
 
 			// Scrap the BLAS.
-			std::map<WeakMaterial, std::vector<SBs::InstanceSB>> target_instances;
+			frame_map<WeakMaterial, frame_vector<SBs::InstanceSB>> target_instances;
 
 			// todo: opaque only.
 			for (const auto& candidates : m_render_candidates_[0] | std::views::values)
@@ -171,4 +171,18 @@ namespace Engine::Manager::Graphics
 			GetRaytracingPipeline().BuildTLAS(cmd, target_instances, m_tmp_instances_);
 		}
 	}
+
+	ManagerAccess RayTracer::GetAccess(const eManagerPhase phase) const
+	{
+		switch (phase)
+		{
+		case MANAGER_PHASE_PRE_UPDATE:
+			return {MANAGER_ACCESS_NONE, MANAGER_ACCESS_RENDER_LIST};
+		case MANAGER_PHASE_PRE_RENDER:
+		case MANAGER_PHASE_RENDER:
+			return g_manager_access_exclusive;
+		default:
+			return g_manager_access_none;
+		}
+	}
 }
@@ -21,6 +21,7 @@ namespace Engine::Manager::Graphics
 		void PostRender(const float& dt) override;
 		void PostUpdate(const float& dt) override;
 		void Initialize() override;
+		ManagerAccess GetAccess(eManagerPhase phase) const override;
 
 		bool   Ready() const;
 		UINT64 GetInstanceCount() const;
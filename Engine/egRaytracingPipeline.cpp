@@ -720,9 +720,9 @@ namespace Engine::Manager::Graphics
 	}
 
 	void RaytracingPipeline::BuildTLAS(
-		ID3D12GraphicsCommandList4*                                 cmd,
-		const std::map<WeakMaterial, std::vector<SBs::InstanceSB>>& instances,
-		std::vector<StructuredBuffer<SBs::InstanceSB>>&             instance_sb
+		ID3D12GraphicsCommandList4*                                   cmd,
+		const frame_map<WeakMaterial, frame_vector<SBs::InstanceSB>>& instances,
+		std::vector<StructuredBuffer<SBs::InstanceSB>>&               instance_sb
 	)
 	{
 		const auto& default_heap = CD3DX12_HEAP_PROPERTIES(D3D12_HEAP_TYPE_DEFAULT);
@@ -926,4 +926,16 @@ namespace Engine::Manager::Graphics
 	{
 		cmd->SetComputeRootShaderResourceView(1, m_tlas_.resultPool.GetGPUAddress());
 	}
+
+	ManagerAccess RaytracingPipeline::GetAccess(const eManagerPhase phase) const
+	{
+		switch (phase)
+		{
+		case MANAGER_PHASE_PRE_RENDER:
+		case MANAGER_PHASE_RENDER:
+			return g_manager_access_exclusive;
+		default:
+			return g_manager_access_none;
+		}
+	}
 }
@@ -5,6 +5,7 @@
 #include "egCommon.hpp"
 #include "egConstantBuffer.hpp"
 #include "egDescriptors.h"
+#include "egFrameArena.hpp"
 #include "egGraphicMemoryPool.hpp"
 #include "egStructuredBuffer.hpp"
 
@@ -36,6 +37,7 @@ namespace Engine::Manager::Graphics
 		explicit RaytracingPipeline(SINGLETON_LOCK_TOKEN) {}
 
 		void Initialize() override;
+		ManagerAccess GetAccess(eManagerPhase phase) const override;
 		void PreRender(const float& dt) override;
 		void PreUpdate(const float& dt) override;
 		void Update(const float& dt) override;
@@ -52,9 +54,9 @@ namespace Engine::Manager::Graphics
 		}
 
 		void BuildTLAS(
-			ID3D12GraphicsCommandList4*                                 cmd,
-			const std::map<WeakMaterial, std::vector<SBs::InstanceSB>>& instances, std::vector<StructuredBuffer<
-				SBs::InstanceSB>>&                                      instance_sb
+			ID3D12GraphicsCommandList4*                                   cmd,
+			const frame_map<WeakMaterial, frame_vector<SBs::InstanceSB>>& instances, std::vector<StructuredBuffer<
+				SBs::InstanceSB>>&                                        instance_sb
 		);
 
 		void SetPerspectiveMatrix(const CBs::PerspectiveCB& matrix);
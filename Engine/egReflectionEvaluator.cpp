@@ -40,4 +40,9 @@ namespace Engine::Manager::Graphics
 	{
 		m_copy_.Unbind(w_cmd, BIND_TYPE_SRV);
 	}
+
+	ManagerAccess ReflectionEvaluator::GetAccess(const eManagerPhase phase) const
+	{
+		return g_manager_access_none;
+	}
 }
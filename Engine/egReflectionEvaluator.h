@@ -34,6 +34,7 @@ namespace Engine::Manager::Graphics
 		void PostRender(const float& dt) override;
 		void PostUpdate(const float& dt) override;
 		void Initialize() override;
+		ManagerAccess GetAccess(eManagerPhase phase) const override;
 
 		void RenderFinished(const Weak<CommandPair>& w_cmd) const;
 
@@ -522,4 +522,15 @@ namespace Engine::Manager::Graphics
 		m_wvp_buffer_data_.Bind(cmd, heap);
 		m_param_buffer_data_.Bind(cmd, heap);
 	}
+
+	ManagerAccess RenderPipeline::GetAccess(const eManagerPhase phase) const
+	{
+		switch (phase)
+		{
+		case MANAGER_PHASE_PRE_RENDER:
+			return g_manager_access_exclusive;
+		default:
+			return g_manager_access_none;
+		}
+	}
 } // namespace Engine::Manager::Graphics
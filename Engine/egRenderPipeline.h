@@ -31,6 +31,7 @@ namespace Engine::Manager::Graphics
 		explicit RenderPipeline(SINGLETON_LOCK_TOKEN) {}
 
 		void Initialize() override;
+		ManagerAccess GetAccess(eManagerPhase phase) const override;
 		void PreRender(const float& dt) override;
 		void PreUpdate(const float& dt) override;
 		void Update(const float& dt) override;
@@ -520,4 +520,15 @@ namespace Engine::Manager
 			}
 		}
 	}
+
+	ManagerAccess ResourceManager::GetAccess(const eManagerPhase phase) const
+	{
+		switch (phase)
+		{
+		case MANAGER_PHASE_PRE_UPDATE:
+			return {MANAGER_ACCESS_NONE, MANAGER_ACCESS_RESOURCE | MANAGER_ACCESS_COMMAND};
+		default:
+			return g_manager_access_none;
+		}
+	}
 }
@@ -18,6 +18,7 @@ namespace Engine::Manager
 		explicit ResourceManager(SINGLETON_LOCK_TOKEN) {}
 
 		void Initialize() override;
+		ManagerAccess GetAccess(eManagerPhase phase) const override;
 		void PreUpdate(const float& dt) override;
 		void Update(const float& dt) override;
 		void PreRender(const float& dt) override;
@@ -10,10 +10,12 @@
 #include <PxScene.h>
 
 #include "egCamera.h"
+#include "egDynamicAABBTree.hpp"
 #include "egImGuiHeler.hpp"
 #include "egLight.h"
 #include "egManagerHelper.hpp"
 #include "egObserver.h"
+#include "egOctree.hpp"
 #include "PhysXSimulationCallback.h"
 
 SERIALIZE_IMPL
@@ -94,13 +96,11 @@ namespace Engine
 		GetTaskScheduler().AddTask
 				(
 				 TASK_INIT_SCENE,
-				 {GetSharedPtr<Scene>()},
-				 [](const std::vector<std::any>& params, const float)
+				 [](const StrongScene& scene, const float)
 				 {
-					 const auto& scene = std::any_cast<StrongScene>(params[0]);
-
 					 scene->initializeFinalize();
-				 }
+				 },
+				 GetSharedPtr<Scene>()
 				);
 
 #ifdef PHYSX_ENABLED
@@ -166,15 +166,11 @@ namespace Engine
 		GetTaskScheduler().AddTask
 				(
 				 TASK_ADD_OBJ,
-				 {GetSharedPtr<Scene>(), obj, layer}, // keep the object alive, scene does not own the object yet.
-				 [](const std::vector<std::any>& params, const float dt)
+				 [](const StrongScene& scene, const StrongObjectBase& obj, const eLayerType layer, const float dt)
 				 {
-					 const auto& scene = std::any_cast<StrongScene>(params[0]);
-					 const auto& obj   = std::any_cast<StrongObjectBase>(params[1]);
-					 const auto& layer = std::any_cast<eLayerType>(params[2]);
-
 					 scene->AddObjectFinalize(layer, obj);
-				 }
+				 },
+				 GetSharedPtr<Scene>(), obj, layer // keep the object alive, scene does not own the object yet.
 				);
 	}
 
@@ -235,10 +231,11 @@ namespace Engine
 
 			if (comp.lock()->GetComponentType() == COM_T_TRANSFORM)
 			{
-				m_object_position_tree_.Remove(obj.lock());
+				m_object_position_tree_->Remove(obj.lock());
 			}
 		}
 
+		m_hash_grid_.Unregister(obj.lock()->GetID());
 		obj.lock()->SetScene({});
 
 		if (obj.lock()->GetLocalID() == m_main_actor_local_id_)
@@ -288,10 +285,11 @@ namespace Engine
 				}
 			}
 
-			m_object_position_tree_.Clear();
+			m_object_position_tree_->Clear();
+			m_hash_grid_.Clear();
 			m_cached_objects_.clear();
 			m_cached_components_.clear();
-			m_object_position_tree_.Clear();
+			m_object_position_tree_->Clear();
 			m_assigned_actor_ids_.clear();
 
 			for (const auto& layer : m_layers)
@@ -354,7 +352,7 @@ namespace Engine
 				}
 			}
 
-			m_object_position_tree_.Update();
+			m_object_position_tree_->Update();
 
 			if (g_debug_observer)
 			{
@@ -392,17 +390,13 @@ namespace Engine
 			GetTaskScheduler().AddTask
 					(
 					 TASK_CHANGE_LAYER,
-					 {GetSharedPtr<Scene>(), obj->GetSharedPtr<Abstract::ObjectBase>(), to},
-					 [this](const std::vector<std::any>& args, const float)
+					 [](const StrongScene& scene, const StrongObjectBase& obj, const eLayerType layer, const float)
 					 {
-						 const auto scene = std::any_cast<StrongScene>(args[0]);
-						 const auto obj   = std::any_cast<StrongObjectBase>(args[1]);
-						 const auto layer = std::any_cast<eLayerType>(args[2]);
-
 						 (*scene)[obj->GetLayer()]->RemoveGameObject(obj->GetID());
 						 (*scene)[layer]->AddGameObject(obj);
 						 obj->SetLayer(layer);
-					 }
+					 },
+					 GetSharedPtr<Scene>(), obj->GetSharedPtr<Abstract::ObjectBase>(), to
 					);
 		}
 	}
@@ -450,13 +444,11 @@ namespace Engine
 		GetTaskScheduler().AddTask
 				(
 				 TASK_REM_OBJ,
-				 {GetSharedPtr<Scene>()},
-				 [id, layer](const std::vector<std::any>& param, const float)
+				 [](const StrongScene& scene, const GlobalEntityID id, const eLayerType layer, const float)
 				 {
-					 const auto& scene = std::any_cast<StrongScene>(param[0]);
-
 					 scene->RemoveObjectFinalize(id, layer);
-				 }
+				 },
+				 GetSharedPtr<Scene>(), id, layer
 				);
 	}
 
@@ -544,7 +536,7 @@ namespace Engine
 
 			if (type == COM_T_TRANSFORM)
 			{
-				m_object_position_tree_.Insert(component->GetOwner().lock());
+				m_object_position_tree_->Insert(component->GetOwner().lock());
 			}
 		}
 	}
@@ -564,7 +556,7 @@ namespace Engine
 
 		if (type == COM_T_TRANSFORM)
 		{
-			m_object_position_tree_.Remove(component->GetOwner().lock());
+			m_object_position_tree_->Remove(component->GetOwner().lock());
 		}
 	}
 
@@ -619,7 +611,7 @@ namespace Engine
 #endif
 		  m_main_camera_local_id_(g_invalid_id),
 		  m_main_actor_local_id_(g_invalid_id),
-		  m_object_position_tree_() {}
+		  m_object_position_tree_(std::make_unique<Octree>()) {}
 
 	void Scene::PreUpdate(const float& dt)
 	{
@@ -636,7 +628,10 @@ namespace Engine
 			m_layers[static_cast<eLayerType>(i)]->Update(dt);
 		}
 
-		m_object_position_tree_.Update();
+		// Routines are resumed after the script updates.
+		m_coroutines_.Update(dt);
+
+		m_object_position_tree_->Update();
 	}
 
 	void Scene::PreRender(const float& dt)
@@ -699,9 +694,89 @@ namespace Engine
 		return m_mainCamera_;
 	}
 
-	const Octree& Scene::GetObjectTree()
+	const SpatialIndex& Scene::GetObjectTree()
+	{
+		return *m_object_position_tree_;
+	}
+
+	void Scene::SetSpatialIndex(const eSpatialIndexType type)
+	{
+		if (type == m_object_position_tree_->GetType())
+		{
+			return;
+		}
+
+		std::unique_ptr<SpatialIndex> tree;
+
+		switch (type)
+		{
+		case SPATIAL_INDEX_OCTREE:
+			tree = std::make_unique<Octree>();
+			break;
+		case SPATIAL_INDEX_AABB_TREE:
+			tree = std::make_unique<DynamicAABBTree>();
+			break;
+		default:
+			throw std::logic_error("Unknown spatial index type");
+		}
+
+		// Consume the pending notifications, otherwise the moved objects will not be published again.
+		std::vector<WeakObjectBase> objects;
+		objects.reserve(m_object_position_tree_->GetCount());
+
+		m_object_position_tree_->Update();
+		m_object_position_tree_->ForEach
+				(
+				 [&objects](const WeakObjectBase& obj)
+				 {
+					 objects.push_back(obj);
+				 }
+				);
+
+		tree->Build(objects);
+		tree->TakeSensors(*m_object_position_tree_);
+
+		m_object_position_tree_ = std::move(tree);
+	}
+
+	eSpatialIndexType Scene::GetSpatialIndexType() const
+	{
+		return m_object_position_tree_->GetType();
+	}
+
+	void Scene::NotifyMoved(const WeakObjectBase& obj)
+	{
+		m_object_position_tree_->Notify(obj);
+	}
+
+	SpatialIndex::SensorID Scene::AddProximitySensor(const BoundingSphere& region, const WeakObjectBase& attached)
+	{
+		return m_object_position_tree_->AddSensor(region, attached);
+	}
+
+	void Scene::MoveProximitySensor(const SpatialIndex::SensorID id, const BoundingSphere& region)
 	{
-		return m_object_position_tree_;
+		m_object_position_tree_->MoveSensor(id, region);
+	}
+
+	void Scene::RemoveProximitySensor(const SpatialIndex::SensorID id)
+	{
+		m_object_position_tree_->RemoveSensor(id);
+	}
+
+	const SpatialIndex::ProximitySensor* Scene::GetProximitySensor(const SpatialIndex::SensorID id) const
+	{
+		return m_object_position_tree_->GetSensor(id);
+	}
+
+	SpatialHashGrid& Scene::GetHashGrid()
+	{
+		return m_hash_grid_;
+	}
+
+	CoroutineScheduler& Scene::GetCoroutineScheduler()
+	{
+		return m_coroutines_;
 	}
 
 	void Scene::AddObserver()
@@ -835,19 +910,21 @@ namespace Engine
 			m_main_camera_local_id_ = cameras.begin()->lock()->GetLocalID();
 		}
 
-		// rebuild octree
-		m_object_position_tree_.Clear();
+		// rebuild spatial index
+		std::vector<WeakObjectBase> objects;
+		objects.reserve(m_cached_objects_.size());
 
 		for (const auto& object : m_cached_objects_ | std::views::values)
 		{
 			if (const auto locked = object.lock();
 				locked->GetComponent<Components::Transform>().lock())
 			{
-				m_object_position_tree_.Insert(locked);
+				objects.push_back(locked);
 			}
 		}
 
-		m_object_position_tree_.Update();
+		m_object_position_tree_->Build(objects);
+		m_object_position_tree_->Update();
 
 		if (m_b_scene_raytracing_ && !g_raytracing)
 		{
@@ -860,14 +937,11 @@ namespace Engine
 				GetTaskScheduler().AddTask
 				(
 					TASK_TOGGLE_RASTER,
-					{ GetSharedPtr<Scene>(), m_b_scene_raytracing_ },
-					[](const std::vector<std::any>& params, const float)
+					[](const StrongScene& scene, const bool b_raytracing, const float)
 					{
-						const auto& scene = std::any_cast<StrongScene>(params[0]);
-						const auto& b_raytracing = std::any_cast<bool>(params[1]);
-
 						g_raytracing = b_raytracing;
-					}
+					},
+					GetSharedPtr<Scene>(), m_b_scene_raytracing_
 				);
 			}
 		}
@@ -895,18 +969,29 @@ namespace Engine
 					GetTaskScheduler().AddTask
 					(
 						TASK_TOGGLE_RASTER,
-						{ GetSharedPtr<Scene>(), m_b_scene_raytracing_ },
-						[](const std::vector<std::any>& params, const float)
+						[](const StrongScene& scene, const bool b_raytracing, const float)
 						{
-							const auto& scene = std::any_cast<StrongScene>(params[0]);
-							const auto& b_raytracing = std::any_cast<bool>(params[1]);
-
 							g_raytracing = b_raytracing;
-						}
+						},
+						GetSharedPtr<Scene>(), m_b_scene_raytracing_
 					);
 				}
 			}
 
+			int spatial_index = GetSpatialIndexType();
+			if (ImGui::Combo("Spatial Index", &spatial_index, g_spatial_index_type_str, SPATIAL_INDEX_MAX))
+			{
+				GetTaskScheduler().AddTask
+				(
+					TASK_SYNC_SCENE,
+					[](const StrongScene& scene, const eSpatialIndexType type, const float)
+					{
+						scene->SetSpatialIndex(type);
+					},
+					GetSharedPtr<Scene>(), static_cast<eSpatialIndexType>(spatial_index)
+				);
+			}
+
 			if (ImGui::BeginListBox(list_name.c_str(), {-1, -1}))
 			{
 				for (int i = LAYER_NONE; i < LAYER_MAX; ++i)
@@ -4,7 +4,8 @@
 #include <boost/serialization/export.hpp>
 #include "egComponent.h"
 #include "egLayer.h"
-#include "egOctree.hpp"
+#include "egSpatialHashGrid.hpp"
+#include "egSpatialIndex.hpp"
 #include "egRenderable.h"
 #include "egScript.h"
 #include "egTaskScheduler.h"
@@ -82,7 +83,24 @@ namespace Engine
 		ConcurrentWeakObjVec GetGameObjects(eLayerType layer) const;
 		WeakCamera           GetMainCamera() const;
 
-		const Octree& GetObjectTree();
+		const SpatialIndex& GetObjectTree();
+		// Grid for the uniform content, scripts register their objects.
+		SpatialHashGrid&    GetHashGrid();
+		CoroutineScheduler& GetCoroutineScheduler();
+
+		// Rebuilds the object tree with the given backend.
+		void              SetSpatialIndex(eSpatialIndexType type);
+		eSpatialIndexType GetSpatialIndexType() const;
+
+		// Queues the moved object for relocating in the object tree, thread-safe.
+		void NotifyMoved(const WeakObjectBase& obj);
+
+		// Proximity sensor on the object tree, kept across the backend changes.
+		SpatialIndex::SensorID AddProximitySensor(const BoundingSphere& region, const WeakObjectBase& attached = {});
+		void                   MoveProximitySensor(SpatialIndex::SensorID id, const BoundingSphere& region);
+		void                   RemoveProximitySensor(SpatialIndex::SensorID id);
+
+		const SpatialIndex::ProximitySensor* GetProximitySensor(SpatialIndex::SensorID id) const;
 
 		// Add cache component from the object.
 		template <typename T, typename CompLock = std::enable_if_t<std::is_base_of_v<Abstract::Component, T>>>
@@ -94,14 +112,11 @@ namespace Engine
 				GetTaskScheduler().AddTask
 						(
 						 TASK_CACHE_COMPONENT,
-						 {GetSharedPtr<Scene>(), component},
-						 [](const std::vector<std::any>& params, const float)
+						 [](const StrongScene& scene, const StrongComponent& component, const float)
 						 {
-							 const auto& scene     = std::any_cast<StrongScene>(params[0]);
-							 const auto& component = std::any_cast<StrongComponent>(params[1]);
-
 							 scene->addCacheComponentImpl(component, component->GetComponentType());
-						 }
+						 },
+						 GetSharedPtr<Scene>(), component
 						);
 			}
 			else
@@ -109,14 +124,11 @@ namespace Engine
 				GetTaskScheduler().AddTask
 						(
 						 TASK_CACHE_COMPONENT,
-						 {GetSharedPtr<Scene>(), component},
-						 [](const std::vector<std::any>& params, const float)
+						 [](const StrongScene& scene, const boost::shared_ptr<T>& component, const float)
 						 {
-							 const auto& scene     = std::any_cast<StrongScene>(params[0]);
-							 const auto& component = std::any_cast<boost::shared_ptr<T>>(params[1]);
-
 							 scene->addCacheComponentImpl(component, which_component<T>::value);
-						 }
+						 },
+						 GetSharedPtr<Scene>(), component
 						);
 			}
 		}
@@ -131,14 +143,11 @@ namespace Engine
 				GetTaskScheduler().AddTask
 						(
 						 TASK_UNCACHE_COMPONENT,
-						 {GetSharedPtr<Scene>(), script},
-						 [](const std::vector<std::any>& params, const float)
+						 [](const StrongScene& scene, const StrongComponent& component, const float)
 						 {
-							 const auto& scene     = std::any_cast<StrongScene>(params[0]);
-							 const auto& component = std::any_cast<StrongComponent>(params[1]);
-
 							 scene->removeCacheComponentImpl(component, component->GetComponentType());
-						 }
+						 },
+						 GetSharedPtr<Scene>(), script
 						);
 			}
 			else
@@ -146,14 +155,11 @@ namespace Engine
 				GetTaskScheduler().AddTask
 						(
 						 TASK_UNCACHE_COMPONENT,
-						 {GetSharedPtr<Scene>(), script},
-						 [](const std::vector<std::any>& params, const float)
+						 [](const StrongScene& scene, const boost::shared_ptr<T>& component, const float)
 						 {
-							 const auto& scene     = std::any_cast<StrongScene>(params[0]);
-							 const auto& component = std::any_cast<boost::shared_ptr<T>>(params[1]);
-
 							 scene->removeCacheComponentImpl(component, which_component<T>::value);
-						 }
+						 },
+						 GetSharedPtr<Scene>(), script
 						);
 			}
 		}
@@ -168,14 +174,11 @@ namespace Engine
 				GetTaskScheduler().AddTask
 						(
 						 TASK_CACHE_SCRIPT,
-						 {GetSharedPtr<Scene>(), script},
-						 [](const std::vector<std::any>& params, const float)
+						 [](const StrongScene& scene, const StrongScript& scp, const float)
 						 {
-							 const auto& scene = std::any_cast<StrongScene>(params[0]);
-							 const auto& scp   = std::any_cast<StrongScript>(params[1]);
-
 							 scene->addCacheScriptImpl(scp, scp->GetScriptType());
-						 }
+						 },
+						 GetSharedPtr<Scene>(), script
 						);
 			}
 			else
@@ -183,14 +186,11 @@ namespace Engine
 				GetTaskScheduler().AddTask
 						(
 						 TASK_CACHE_COMPONENT,
-						 {GetSharedPtr<Scene>(), script},
-						 [](const std::vector<std::any>& params, const float)
+						 [](const StrongScene& scene, const boost::shared_ptr<T>& component, const float)
 						 {
-							 const auto& scene     = std::any_cast<StrongScene>(params[0]);
-							 const auto& component = std::any_cast<boost::shared_ptr<T>>(params[1]);
-
 							 scene->addCacheScriptImpl(component, which_script<T>::value);
-						 }
+						 },
+						 GetSharedPtr<Scene>(), script
 						);
 			}
 		}
@@ -205,14 +205,11 @@ namespace Engine
 				GetTaskScheduler().AddTask
 						(
 						 TASK_UNCACHE_SCRIPT,
-						 {GetSharedPtr<Scene>(), script},
-						 [](const std::vector<std::any>& params, const float)
+						 [](const StrongScene& scene, const StrongScript& scp, const float)
 						 {
-							 const auto& scene = std::any_cast<StrongScene>(params[0]);
-							 const auto& scp   = std::any_cast<StrongScript>(params[1]);
-
 							 scene->removeCacheScriptImpl(scp, scp->GetScriptType());
-						 }
+						 },
+						 GetSharedPtr<Scene>(), script
 						);
 			}
 			else
@@ -220,14 +217,11 @@ namespace Engine
 				GetTaskScheduler().AddTask
 						(
 						 TASK_UNCACHE_SCRIPT,
-						 {GetSharedPtr<Scene>(), script},
-						 [](const std::vector<std::any>& params, const float)
+						 [](const StrongScene& scene, const boost::shared_ptr<T>& scp, const float)
 						 {
-							 const auto& scene = std::any_cast<StrongScene>(params[0]);
-							 const auto& scp   = std::any_cast<boost::shared_ptr<T>>(params[1]);
-
 							 scene->removeCacheScriptImpl(scp, which_script<T>::value);
-						 }
+						 },
+						 GetSharedPtr<Scene>(), script
 						);
 			}
 		}
@@ -252,6 +246,29 @@ namespace Engine
 			return {};
 		}
 
+		// Alive cached components in the contiguous array, elements can be processed in parallel by index.
+		template <typename T>
+		std::vector<boost::shared_ptr<T>> GetLockedComponents()
+		{
+			ConcurrentWeakComRootMap::const_accessor acc;
+			std::vector<boost::shared_ptr<T>>         result;
+
+			if (m_cached_components_.find(acc, which_component<T>::value))
+			{
+				result.reserve(acc->second.size());
+
+				for (const auto& comp : acc->second | std::views::values)
+				{
+					if (const auto locked = comp.lock())
+					{
+						result.push_back(locked->template GetSharedPtr<T>());
+					}
+				}
+			}
+
+			return result;
+		}
+
 		template <typename T>
 		ConcurrentWeakScpVec GetCachedScripts()
 		{
@@ -351,7 +368,10 @@ namespace Engine
 		ConcurrentWeakObjGlobalMap m_cached_objects_;
 		ConcurrentWeakComRootMap   m_cached_components_;
 		ConcurrentWeakScpRootMap   m_cached_scripts_;
-		Octree                     m_object_position_tree_;
+		// Non-serialized, the scene starts with the octree.
+		std::unique_ptr<SpatialIndex> m_object_position_tree_;
+		SpatialHashGrid               m_hash_grid_;
+		CoroutineScheduler         m_coroutines_;
 
 #ifdef PHYSX_ENABLED
 	public:
@@ -229,13 +229,11 @@ namespace Engine::Manager
 				GetTaskScheduler().AddTask
 						(
 						 TASK_SYNC_SCENE,
-						 {*target, param_scene},
-						 [this](const std::vector<std::any>& params, float)
+						 [](const StrongScene& target_scene, const StrongScene& scene, float)
 						 {
-							 const auto target = std::any_cast<StrongScene>(params[0]);
-							 const auto scene  = std::any_cast<StrongScene>(params[1]);
-							 target->synchronize(scene);
-						 }
+							 target_scene->synchronize(scene);
+						 },
+						 *target, param_scene
 						);
 			}
 			else
@@ -42,12 +42,11 @@ namespace Engine::Manager
 				GetTaskScheduler().AddTask
 						(
 						 TASK_ACTIVE_SCENE,
-						 {*scene},
-						 [name, this](const std::vector<std::any>& params, float)
+						 [this](const StrongScene& s, float)
 						 {
-							 const auto s = std::any_cast<StrongScene>(params[0]);
 							 SetActiveFinalize(s);
-						 }
+						 },
+						 *scene
 						);
 			}
 		}
@@ -85,13 +84,11 @@ namespace Engine::Manager
 				GetTaskScheduler().AddTask
 						(
 						 TASK_REM_SCENE,
-						 {*scene, name},
-						 [this](const std::vector<std::any>& params, float)
+						 [this](const StrongScene& target, const std::string& target_name, float)
 						 {
-							 const auto scene = std::any_cast<StrongScene>(params[0]);
-							 const auto name  = std::any_cast<std::string>(params[1]);
-							 RemoveSceneFinalize(scene, name);
-						 }
+							 RemoveSceneFinalize(target, target_name);
+						 },
+						 *scene, name
 						);
 			}
 		}
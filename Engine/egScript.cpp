@@ -1,6 +1,8 @@
 #include "pch.h"
 #include "egScript.h"
 
+#include "egScene.hpp"
+
 SERIALIZE_IMPL
 (
  Engine::Script,
@@ -29,6 +31,28 @@ Engine::StrongScript Engine::Script::Clone(const WeakObjectBase& owner) const
 	return clone;
 }
 
+void Engine::Script::StartCoroutine(Coroutine&& coroutine)
+{
+	if (const auto owner = GetOwner().lock())
+	{
+		if (const auto scene = owner->GetScene().lock())
+		{
+			scene->GetCoroutineScheduler().Start(GetWeakPtr<Script>(), std::move(coroutine));
+		}
+	}
+}
+
+void Engine::Script::StopCoroutines()
+{
+	if (const auto owner = GetOwner().lock())
+	{
+		if (const auto scene = owner->GetScene().lock())
+		{
+			scene->GetCoroutineScheduler().Stop(this);
+		}
+	}
+}
+
 Engine::Script::Script()
 	: m_type_(),
 	  m_b_active_(true) {}
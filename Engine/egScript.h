@@ -1,5 +1,6 @@
 #pragma once
 #include "egCommon.hpp"
+#include "egCoroutine.h"
 #include "egRenderable.h"
 
 namespace Engine
@@ -29,6 +30,11 @@ namespace Engine
 
 		[[nodiscard]] StrongScript Clone(const WeakObjectBase& owner) const;
 
+		// Run the routine in the scene where the owner belongs to. Routine is paused while the script is
+		// inactive and dropped when the script is destroyed.
+		void StartCoroutine(Coroutine&& coroutine);
+		void StopCoroutines();
+
 		using ScriptFactoryFunction = std::function<StrongScript(const WeakObjectBase&)>;
 
 		template <typename T, typename SLock = std::enable_if_t<std::is_base_of_v<Script, T>>>
@@ -229,11 +229,12 @@ namespace Engine::Manager::Graphics
 				 cmd,
 				 m_shadow_descriptor_heap_,
 				 m_shadow_instance_buffer_,
-				 [this](const StrongObjectBase& obj)
+				 [this](const CandidateTuple& candidate)
 				 {
-					 if (obj->GetLayer() == LAYER_CAMERA || obj->GetLayer() == LAYER_UI || obj->GetLayer() ==
-					     LAYER_ENVIRONMENT ||
-					     obj->GetLayer() == LAYER_LIGHT || obj->GetLayer() == LAYER_SKYBOX)
+					 const eLayerType layer = std::get<3>(candidate);
+
+					 if (layer == LAYER_CAMERA || layer == LAYER_UI || layer == LAYER_ENVIRONMENT ||
+					     layer == LAYER_LIGHT || layer == LAYER_SKYBOX)
 					 {
 						 return false;
 					 }
@@ -563,4 +564,17 @@ namespace Engine::Manager::Graphics
 
 		cmd->GetList()->ResourceBarrier(1, &rtv_to_common);
 	}
+
+	ManagerAccess ShadowManager::GetAccess(const eManagerPhase phase) const
+	{
+		switch (phase)
+		{
+		case MANAGER_PHASE_PRE_UPDATE:
+			return {MANAGER_ACCESS_NONE, MANAGER_ACCESS_LIGHT | MANAGER_ACCESS_COMMAND};
+		case MANAGER_PHASE_PRE_RENDER:
+			return g_manager_access_exclusive;
+		default:
+			return g_manager_access_none;
+		}
+	}
 } // namespace Engine::Manager::Graphics
@@ -24,6 +24,7 @@ namespace Engine::Manager::Graphics
 			  m_shadow_map_mask_("", {}) {}
 
 		void Initialize() override;
+		ManagerAccess GetAccess(eManagerPhase phase) const override;
 		void PreUpdate(const float& dt) override;
 		void Update(const float& dt) override;
 		void GetLightVP(const boost::shared_ptr<Scene>& scene, std::vector<SBs::LightVPSB>& current_light_vp);
@@ -9,6 +9,7 @@
 #include "egBaseAnimation.h"
 #include "egBone.h"
 #include "egBoneAnimation.h"
+#include "egConvexHull.hpp"
 #include "egMesh.h"
 #include "egResourceManager.hpp"
 
@@ -22,13 +23,18 @@ SERIALIZE_IMPL
  _ARTAG(m_mesh_paths_)
  _ARTAG(m_bounding_box_)
  _ARTAG(m_bone_bounding_boxes_)
+ if (file_version > 0)
+ {
+  _ARTAG(m_hull_)
+ }
 )
 
 namespace Engine::Resources
 {
 	Shape::Shape(const std::filesystem::path& path)
 		: Resource(path, RES_T_SHAPE),
-		  m_bounding_box_({}) {}
+		  m_bounding_box_({}),
+		  m_revision_(0) {}
 
 	void Shape::PreUpdate(const float& dt) {}
 
@@ -67,6 +73,9 @@ namespace Engine::Resources
 			Serializer::Serialize(m_animations_->GetName(), m_animations_);
 			m_animations_path_ = m_animations_->GetMetadataPath().generic_string();
 		}
+
+		// Saves the hull, so the collider does not build it on every load.
+		GetHull();
 	}
 
 	void Shape::OnDeserialized()
@@ -135,8 +144,24 @@ namespace Engine::Resources
 		return m_bone_bounding_boxes_;
 	}
 
+	boost::shared_ptr<const Physics::ConvexHull> Shape::GetHull()
+	{
+		if (!m_hull_ && !m_cached_vertices_.empty())
+		{
+			m_hull_ = boost::make_shared<Physics::ConvexHull>(Physics::ConvexHull::Build(m_cached_vertices_));
+		}
+
+		return m_hull_;
+	}
+
+	UINT Shape::GetRevision() const
+	{
+		return m_revision_;
+	}
+
 	void Shape::UpdateVertices()
 	{
+		++m_revision_;
 		m_cached_vertices_.clear();
 
 		for (const auto& mesh : m_meshes_)
@@ -539,11 +564,14 @@ namespace Engine::Resources
 		m_animation_catalog_.clear();
 		m_bone_bounding_boxes_.clear();
 		m_cached_vertices_.clear();
+		m_hull_.reset();
+		++m_revision_;
 		m_bounding_box_ = {};
 		m_bone_.reset();
 	}
 
 	Shape::Shape()
 		: Resource("", RES_T_SHAPE),
-		  m_bounding_box_({}) {}
+		  m_bounding_box_({}),
+		  m_revision_(0) {}
 }
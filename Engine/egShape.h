@@ -5,6 +5,11 @@
 #include "egMesh.h"
 #include "egResource.h"
 
+namespace Engine::Physics
+{
+	struct ConvexHull;
+}
+
 namespace Engine::Resources
 {
 	class Shape : public Abstract::Resource
@@ -30,6 +35,10 @@ namespace Engine::Resources
 		std::vector<StrongMesh>                    GetMeshes() const;
 		const std::vector<std::string>&            GetAnimationCatalog() const;
 		const std::map<UINT, BoundingOrientedBox>& GetBoneBoundingBoxes() const;
+		// Convex hull of the vertices for the collision, built on the first use and saved with the metadata.
+		boost::shared_ptr<const Physics::ConvexHull> GetHull();
+		// Increased whenever the vertices are changed, the users of the hull refresh it with this.
+		UINT GetRevision() const;
 
 		template <typename T, typename ResLock = std::enable_if_t<std::is_base_of_v<Resource, T>>>
 		void Add(const boost::weak_ptr<T>& res)
@@ -71,6 +80,7 @@ namespace Engine::Resources
 				static_assert("Invalid resource type");
 			}
 
+			m_hull_.reset();
 			UpdateVertices();
 		}
 
@@ -95,6 +105,7 @@ namespace Engine::Resources
 
 		BoundingBox                         m_bounding_box_;
 		std::map<UINT, BoundingOrientedBox> m_bone_bounding_boxes_;
+		boost::shared_ptr<Physics::ConvexHull> m_hull_;
 
 		// non-serialized
 		inline static Assimp::Importer s_importer_;
@@ -103,7 +114,10 @@ namespace Engine::Resources
 		StrongAnimsTexture             m_animations_;
 
 		std::vector<VertexElement> m_cached_vertices_;
+		UINT                       m_revision_;
 	};
 }
 
 BOOST_CLASS_EXPORT_KEY(Engine::Resources::Shape)
+// Version 1 saves the convex hull.
+BOOST_CLASS_VERSION(Engine::Resources::Shape, 1)
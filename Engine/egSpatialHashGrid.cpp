@@ -0,0 +1,195 @@
+#include "pch.h"
+#include "egSpatialHashGrid.hpp"
+
+#include "egObjectBase.hpp"
+
+namespace Engine
+{
+	SpatialHashGrid::SpatialHashGrid(const Vector3& cell_size)
+		: m_cell_size_(cell_size) {}
+
+	void SpatialHashGrid::SetCellSize(const Vector3& cell_size)
+	{
+		if (cell_size.x <= 0.f || cell_size.y <= 0.f || cell_size.z <= 0.f)
+		{
+			return;
+		}
+
+		m_cell_size_ = cell_size;
+		Clear();
+	}
+
+	const Vector3& SpatialHashGrid::GetCellSize() const
+	{
+		return m_cell_size_;
+	}
+
+	size_t SpatialHashGrid::GetCount() const
+	{
+		return m_lookup_.size();
+	}
+
+	SpatialHashGrid::Cell SpatialHashGrid::GetCell(const Vector3& position) const
+	{
+		return {
+			static_cast<int>(std::floor(position.x / m_cell_size_.x)),
+			static_cast<int>(std::floor(position.y / m_cell_size_.y)),
+			static_cast<int>(std::floor(position.z / m_cell_size_.z))
+		};
+	}
+
+	Vector3 SpatialHashGrid::GetCellCenter(const Cell& cell) const
+	{
+		return {
+			(static_cast<float>(cell.x) + 0.5f) * m_cell_size_.x,
+			(static_cast<float>(cell.y) + 0.5f) * m_cell_size_.y,
+			(static_cast<float>(cell.z) + 0.5f) * m_cell_size_.z
+		};
+	}
+
+	void SpatialHashGrid::Register(const WeakT& obj, const Vector3& position)
+	{
+		const auto locked = obj.lock();
+
+		if (!locked)
+		{
+			return;
+		}
+
+		const GlobalEntityID id   = locked->GetID();
+		const Cell           cell = GetCell(position);
+
+		if (const auto it = m_lookup_.find(id); it != m_lookup_.end())
+		{
+			if (it->second == cell)
+			{
+				return;
+			}
+
+			remove(id, it->second);
+		}
+
+		m_cells_[cell].push_back({id, obj});
+		m_lookup_[id] = cell;
+	}
+
+	void SpatialHashGrid::Unregister(const GlobalEntityID id)
+	{
+		if (const auto it = m_lookup_.find(id); it != m_lookup_.end())
+		{
+			remove(id, it->second);
+			m_lookup_.erase(it);
+		}
+	}
+
+	void SpatialHashGrid::Clear()
+	{
+		m_cells_.clear();
+		m_lookup_.clear();
+	}
+
+	void SpatialHashGrid::ForEachIn(const Cell& cell, const ObjectFunc& func) const
+	{
+		if (const auto it = m_cells_.find(cell); it != m_cells_.end())
+		{
+			for (const Entry& entry : it->second)
+			{
+				func(entry.object);
+			}
+		}
+	}
+
+	void SpatialHashGrid::ForEachNeighbour(const Cell& cell, const ObjectFunc& func) const
+	{
+		for (int x = -1; x <= 1; ++x)
+		{
+			for (int y = -1; y <= 1; ++y)
+			{
+				for (int z = -1; z <= 1; ++z)
+				{
+					ForEachIn({cell.x + x, cell.y + y, cell.z + z}, func);
+				}
+			}
+		}
+	}
+
+	void SpatialHashGrid::DepthRay(
+		const Vector3& position, const Vector3& axis, const int range, const std::function<bool(const WeakT&)>& func
+	) const
+	{
+		const Vector3 abs_axis = {std::fabsf(axis.x), std::fabsf(axis.y), std::fabsf(axis.z)};
+
+		// Depth is walked on the dominant axis only, the content is axis aligned.
+		Cell step = {0, 0, 0};
+
+		if (abs_axis.x >= abs_axis.y && abs_axis.x >= abs_axis.z)
+		{
+			step.x = axis.x < 0.f ? -1 : 1;
+		}
+		else if (abs_axis.y >= abs_axis.z)
+		{
+			step.y = axis.y < 0.f ? -1 : 1;
+		}
+		else
+		{
+			step.z = axis.z < 0.f ? -1 : 1;
+		}
+
+		const Cell origin = GetCell(position);
+
+		const auto visit = [this, &func](const Cell& cell)
+		{
+			if (const auto it = m_cells_.find(cell); it != m_cells_.end())
+			{
+				for (const Entry& entry : it->second)
+				{
+					if (func(entry.object))
+					{
+						return true;
+					}
+				}
+			}
+
+			return false;
+		};
+
+		if (visit(origin))
+		{
+			return;
+		}
+
+		for (int i = 1; i <= range; ++i)
+		{
+			const Cell forward  = {origin.x + step.x * i, origin.y + step.y * i, origin.z + step.z * i};
+			const Cell backward = {origin.x - step.x * i, origin.y - step.y * i, origin.z - step.z * i};
+
+			if (visit(forward) || visit(backward))
+			{
+				return;
+			}
+		}
+	}
+
+	void SpatialHashGrid::remove(const GlobalEntityID id, const Cell& cell)
+	{
+		const auto it = m_cells_.find(cell);
+
+		if (it == m_cells_.end())
+		{
+			return;
+		}
+
+		std::erase_if
+				(
+				 it->second, [id](const Entry& entry)
+				 {
+					 return entry.id == id;
+				 }
+				);
+
+		if (it->second.empty())
+		{
+			m_cells_.erase(it);
+		}
+	}
+}
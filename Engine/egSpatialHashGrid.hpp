@@ -0,0 +1,79 @@
+#pragma once
+#include <functional>
+#include <unordered_map>
+#include <vector>
+#include <boost/smart_ptr/weak_ptr.hpp>
+
+namespace Engine
+{
+	// Uniform grid hashed by the integer cell coordinates. Fits the axis aligned content of the same size such
+	// as the cube worlds, the lookup of a cell and its neighbours is constant. Objects are registered by the
+	// scripts, not by the scene, and the grid is not thread-safe.
+	class SpatialHashGrid
+	{
+	public:
+		using WeakT = boost::weak_ptr<Abstract::ObjectBase>;
+		using ObjectFunc = std::function<void(const WeakT&)>;
+
+		struct Cell
+		{
+			int x;
+			int y;
+			int z;
+
+			bool operator==(const Cell& other) const = default;
+		};
+
+		struct CellHash
+		{
+			size_t operator()(const Cell& cell) const noexcept
+			{
+				return static_cast<size_t>(cell.x) * 73856093 ^
+				       static_cast<size_t>(cell.y) * 19349663 ^
+				       static_cast<size_t>(cell.z) * 83492791;
+			}
+		};
+
+		explicit SpatialHashGrid(const Vector3& cell_size = Vector3::One);
+
+		SpatialHashGrid(const SpatialHashGrid&)            = delete;
+		SpatialHashGrid& operator=(const SpatialHashGrid&) = delete;
+
+		// Changing the cell size drops every registered object.
+		void           SetCellSize(const Vector3& cell_size);
+		const Vector3& GetCellSize() const;
+		size_t         GetCount() const;
+
+		Cell    GetCell(const Vector3& position) const;
+		Vector3 GetCellCenter(const Cell& cell) const;
+
+		// Registers the object at the position, moves it if it is already registered.
+		void Register(const WeakT& obj, const Vector3& position);
+		void Unregister(GlobalEntityID id);
+		void Clear();
+
+		// Visits the objects in the cell.
+		void ForEachIn(const Cell& cell, const ObjectFunc& func) const;
+		// Visits the cell and its 26 neighbours.
+		void ForEachNeighbour(const Cell& cell, const ObjectFunc& func) const;
+		// Walks the cells from the position along the dominant axis of the given axis, in the order of the depth
+		// from the position to the both sides up to the range. Stops if the function returns true.
+		void DepthRay(
+			const Vector3& position, const Vector3& axis, int range, const std::function<bool(const WeakT&)>& func
+		) const;
+
+	private:
+		struct Entry
+		{
+			GlobalEntityID id;
+			WeakT          object;
+		};
+
+		void remove(GlobalEntityID id, const Cell& cell);
+
+		Vector3 m_cell_size_;
+
+		std::unordered_map<Cell, std::vector<Entry>, CellHash> m_cells_;
+		std::unordered_map<GlobalEntityID, Cell>               m_lookup_;
+	};
+}
@@ -0,0 +1,347 @@
+#include "pch.h"
+#include "egSpatialIndex.hpp"
+
+#include "egTransform.h"
+
+namespace Engine
+{
+	void SpatialIndex::Build(const std::span<const WeakT> objects)
+	{
+		Clear();
+
+		for (const WeakT& obj : objects)
+		{
+			Insert(obj);
+		}
+	}
+
+	void SpatialIndex::Notify(const WeakT& obj)
+	{
+		m_moved_.push(obj);
+	}
+
+	SpatialIndex::SensorID SpatialIndex::AddSensor(const BoundingSphere& region, const WeakT& attached)
+	{
+		const SensorID   id     = m_next_sensor_id_++;
+		ProximitySensor& sensor = m_sensors_[id];
+
+		sensor.region = region;
+
+		if (const auto locked = attached.lock())
+		{
+			sensor.attached = locked->GetID();
+		}
+
+		reseed(sensor);
+
+		return id;
+	}
+
+	void SpatialIndex::MoveSensor(const SensorID id, const BoundingSphere& region)
+	{
+		if (const auto it = m_sensors_.find(id); it != m_sensors_.end())
+		{
+			it->second.region = region;
+			reseed(it->second);
+		}
+	}
+
+	void SpatialIndex::RemoveSensor(const SensorID id)
+	{
+		m_sensors_.erase(id);
+	}
+
+	const SpatialIndex::ProximitySensor* SpatialIndex::GetSensor(const SensorID id) const
+	{
+		if (const auto it = m_sensors_.find(id); it != m_sensors_.end())
+		{
+			return &it->second;
+		}
+
+		return nullptr;
+	}
+
+	void SpatialIndex::TakeSensors(SpatialIndex& other)
+	{
+		m_sensors_        = std::move(other.m_sensors_);
+		m_next_sensor_id_ = other.m_next_sensor_id_;
+		other.m_sensors_.clear();
+
+		reseedSensors();
+	}
+
+	SpatialIndex::RayHits SpatialIndex::HitscanBatch(
+		const std::span<const Ray> rays, const size_t count, const float distance
+	) const
+	{
+		RayHits result(rays.size());
+
+		for (size_t begin = 0; begin < rays.size(); begin += packet_width)
+		{
+			const size_t lanes = std::min(packet_width, rays.size() - begin);
+
+			alignas(16) std::array<float, packet_width> ox{}, oy{}, oz{};
+			alignas(16) std::array<float, packet_width> ix{}, iy{}, iz{};
+
+			RayPacket packet{};
+			packet.lane_mask = 0;
+
+			for (size_t lane = 0; lane < lanes; ++lane)
+			{
+				const Ray& ray = rays[begin + lane];
+				Vector3    dir = ray.direction;
+				dir.Normalize();
+
+				// Axis parallel ray, keeps the slab distance infinite instead of nan.
+				const auto inverse = [](const float v)
+				{
+					return 1.f / (std::fabsf(v) < g_epsilon ? std::copysign(g_epsilon, v) : v);
+				};
+
+				ox[lane] = ray.position.x;
+				oy[lane] = ray.position.y;
+				oz[lane] = ray.position.z;
+				ix[lane] = inverse(dir.x);
+				iy[lane] = inverse(dir.y);
+				iz[lane] = inverse(dir.z);
+
+				packet.lane_mask |= 1 << lane;
+			}
+
+			packet.origin_x        = _mm_load_ps(ox.data());
+			packet.origin_y        = _mm_load_ps(oy.data());
+			packet.origin_z        = _mm_load_ps(oz.data());
+			packet.inv_direction_x = _mm_load_ps(ix.data());
+			packet.inv_direction_y = _mm_load_ps(iy.data());
+			packet.inv_direction_z = _mm_load_ps(iz.data());
+			packet.max_distance    = _mm_set1_ps
+					(
+					 FloatCompare(distance, 0.f) ? std::numeric_limits<float>::infinity() : distance
+					);
+
+			PacketHits hits;
+			hitscanPacket(packet, hits);
+
+			for (size_t lane = 0; lane < lanes; ++lane)
+			{
+				auto& lane_hits = hits[lane];
+
+				std::ranges::sort
+						(
+						 lane_hits, [](const auto& lhs, const auto& rhs)
+						 {
+							 return lhs.first < rhs.first;
+						 }
+						);
+
+				if (count != 0 && lane_hits.size() > count)
+				{
+					lane_hits.resize(count);
+				}
+
+				auto& ray_result = result[begin + lane];
+				ray_result.reserve(lane_hits.size());
+
+				for (auto& hit : lane_hits | std::views::values)
+				{
+					ray_result.push_back(std::move(hit));
+				}
+			}
+		}
+
+		return result;
+	}
+
+	int SpatialIndex::IntersectPacket(
+		const BoundingBox& bounds, const RayPacket& packet, const int mask, __m128& distance
+	)
+	{
+		const Vector3 min = Vector3(bounds.Center) - Vector3(bounds.Extents);
+		const Vector3 max = Vector3(bounds.Center) + Vector3(bounds.Extents);
+
+		const __m128 x0 = _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(min.x), packet.origin_x), packet.inv_direction_x);
+		const __m128 x1 = _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(max.x), packet.origin_x), packet.inv_direction_x);
+		const __m128 y0 = _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(min.y), packet.origin_y), packet.inv_direction_y);
+		const __m128 y1 = _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(max.y), packet.origin_y), packet.inv_direction_y);
+		const __m128 z0 = _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(min.z), packet.origin_z), packet.inv_direction_z);
+		const __m128 z1 = _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(max.z), packet.origin_z), packet.inv_direction_z);
+
+		// Entry is the farthest near plane, exit is the nearest far plane. Origin inside the bounds enters at 0.
+		__m128 t_min = _mm_max_ps(_mm_min_ps(x0, x1), _mm_min_ps(y0, y1));
+		t_min        = _mm_max_ps(t_min, _mm_min_ps(z0, z1));
+		t_min        = _mm_max_ps(t_min, _mm_setzero_ps());
+
+		__m128 t_max = _mm_min_ps(_mm_max_ps(x0, x1), _mm_max_ps(y0, y1));
+		t_max        = _mm_min_ps(t_max, _mm_max_ps(z0, z1));
+		t_max        = _mm_min_ps(t_max, packet.max_distance);
+
+		distance = t_min;
+		return _mm_movemask_ps(_mm_cmple_ps(t_min, t_max)) & mask;
+	}
+
+	void SpatialIndex::AppendHits(const int hit, const __m128 distance, const WeakT& object, PacketHits& hits)
+	{
+		alignas(16) std::array<float, packet_width> lane_distance;
+		_mm_store_ps(lane_distance.data(), distance);
+
+		for (size_t lane = 0; lane < packet_width; ++lane)
+		{
+			if (hit & (1 << lane))
+			{
+				hits[lane].emplace_back(lane_distance[lane], object);
+			}
+		}
+	}
+
+	float __vectorcall SpatialIndex::DistanceSquared(const BoundingBox& bounds, const Vector3& point)
+	{
+		const Vector3 min = Vector3(bounds.Center) - bounds.Extents;
+		const Vector3 max = Vector3(bounds.Center) + bounds.Extents;
+
+		Vector3 closest;
+		point.Clamp(min, max, closest);
+
+		return Vector3::DistanceSquared(point, closest);
+	}
+
+	bool SpatialIndex::popMoved(StrongObjectBase& obj)
+	{
+		WeakT moved;
+
+		while (m_moved_.try_pop(moved))
+		{
+			obj = moved.lock();
+
+			if (!obj)
+			{
+				continue;
+			}
+
+			if (const auto transform = obj->GetComponent<Components::Transform>().lock())
+			{
+				transform->m_b_moved_.store(false, std::memory_order_release);
+			}
+
+			return true;
+		}
+
+		return false;
+	}
+
+	void SpatialIndex::clearMoved()
+	{
+		m_moved_.clear();
+	}
+
+	void SpatialIndex::clearSensorEvents()
+	{
+		for (ProximitySensor& sensor : m_sensors_ | std::views::values)
+		{
+			sensor.entered.clear();
+			sensor.exited.clear();
+		}
+	}
+
+	void SpatialIndex::sense(const GlobalEntityID id, const WeakT& obj, const BoundingBox& bounds)
+	{
+		for (ProximitySensor& sensor : m_sensors_ | std::views::values)
+		{
+			// Sensor follows the object, the members are re-evaluated around the new center.
+			if (sensor.attached == id)
+			{
+				sensor.region.Center = bounds.Center;
+				reseed(sensor);
+				continue;
+			}
+
+			const bool inside = sensor.region.Intersects(bounds);
+			const auto it     = sensor.members.find(id);
+
+			if (inside && it == sensor.members.end())
+			{
+				sensor.members.emplace(id, obj);
+				sensor.entered.push_back(obj);
+			}
+			else if (!inside && it != sensor.members.end())
+			{
+				sensor.exited.push_back(it->second);
+				sensor.members.erase(it);
+			}
+		}
+	}
+
+	void SpatialIndex::unsense(const GlobalEntityID id)
+	{
+		std::erase_if
+				(
+				 m_sensors_, [id](const auto& pair)
+				 {
+					 return pair.second.attached == id;
+				 }
+				);
+
+		for (ProximitySensor& sensor : m_sensors_ | std::views::values)
+		{
+			if (const auto it = sensor.members.find(id); it != sensor.members.end())
+			{
+				sensor.exited.push_back(it->second);
+				sensor.members.erase(it);
+			}
+		}
+	}
+
+	void SpatialIndex::leaveSensors()
+	{
+		for (ProximitySensor& sensor : m_sensors_ | std::views::values)
+		{
+			for (const WeakT& obj : sensor.members | std::views::values)
+			{
+				sensor.exited.push_back(obj);
+			}
+
+			sensor.members.clear();
+		}
+	}
+
+	void SpatialIndex::reseedSensors()
+	{
+		for (ProximitySensor& sensor : m_sensors_ | std::views::values)
+		{
+			reseed(sensor);
+		}
+	}
+
+	void SpatialIndex::reseed(ProximitySensor& sensor) const
+	{
+		std::unordered_map<GlobalEntityID, WeakT> current;
+
+		QueryRegion
+				(
+				 sensor.region, [&current, &sensor](const WeakT& obj)
+				 {
+					 if (const auto locked = obj.lock(); locked && locked->GetID() != sensor.attached)
+					 {
+						 current.emplace(locked->GetID(), obj);
+					 }
+				 }
+				);
+
+		for (const auto& [id, obj] : sensor.members)
+		{
+			if (!current.contains(id))
+			{
+				sensor.exited.push_back(obj);
+			}
+		}
+
+		for (const auto& [id, obj] : current)
+		{
+			if (!sensor.members.contains(id))
+			{
+				sensor.entered.push_back(obj);
+			}
+		}
+
+		sensor.members = std::move(current);
+	}
+}
@@ -0,0 +1,144 @@
+#pragma once
+#include <array>
+#include <functional>
+#include <span>
+#include <unordered_map>
+#include <vector>
+#include <boost/smart_ptr/weak_ptr.hpp>
+#include "egFrameArena.hpp"
+#include "egGenericBounding.hpp"
+
+namespace Engine
+{
+	// Spatial structure of the scene objects. Backend is chosen per scene, the consumers should not rely on
+	// the layout of the backend.
+	class SpatialIndex
+	{
+	public:
+		using WeakT = boost::weak_ptr<Abstract::ObjectBase>;
+		using ObjectFunc = std::function<void(const WeakT&)>;
+		using PairFunc = std::function<void(GlobalEntityID, GlobalEntityID)>;
+		using BoundsFunc = std::function<void(GlobalEntityID, const WeakT&, const BoundingBox&)>;
+		using RayHits = std::vector<std::vector<WeakT>>;
+		using SensorID = UINT;
+
+		constexpr static SensorID invalid_sensor = std::numeric_limits<SensorID>::max();
+
+		// Sphere which keeps the objects intersecting with it. Membership is updated by the move, the insertion
+		// and the removal of the objects, and the deltas are kept until the next update of the index.
+		struct ProximitySensor
+		{
+			BoundingSphere                            region;
+			std::unordered_map<GlobalEntityID, WeakT> members;
+			std::vector<WeakT>                        entered;
+			std::vector<WeakT>                        exited;
+			// Object that the sensor follows, the sensor is dropped with the object.
+			GlobalEntityID attached = g_invalid_id;
+		};
+
+		SpatialIndex()                               = default;
+		SpatialIndex(const SpatialIndex&)            = delete;
+		SpatialIndex& operator=(const SpatialIndex&) = delete;
+		virtual ~SpatialIndex()                      = default;
+
+		virtual eSpatialIndexType GetType() const = 0;
+		virtual size_t            GetCount() const = 0;
+
+		virtual bool Insert(const WeakT& obj) = 0;
+		virtual void Remove(const WeakT& obj) = 0;
+		// Relocates the notified objects.
+		virtual void Update() = 0;
+		virtual void Clear() = 0;
+		// Replaces the content with the given objects. Inserts one by one unless the backend has a bulk path.
+		virtual void Build(std::span<const WeakT> objects);
+
+		// Queues the moved object, thread-safe. Relocated in the next update.
+		void Notify(const WeakT& obj);
+
+		// Adds the sensor, the region is queried once and kept up to date afterwards. If the object is given,
+		// the sensor is centered on the object whenever it moves.
+		SensorID               AddSensor(const BoundingSphere& region, const WeakT& attached = {});
+		void                   MoveSensor(SensorID id, const BoundingSphere& region);
+		void                   RemoveSensor(SensorID id);
+		const ProximitySensor* GetSensor(SensorID id) const;
+		// Takes the sensors of the other index, the members are re-evaluated by this index.
+		void TakeSensors(SpatialIndex& other);
+
+		// Visits every object in the index.
+		virtual void ForEach(const ObjectFunc& func) const = 0;
+		// Visits every object with the bounds cached by the index.
+		virtual void ForEachBounds(const BoundsFunc& func) const = 0;
+		// Visits the pairs of the object ids that are close enough to be tested, each pair is given once.
+		virtual void QueryPairs(const PairFunc& func) const = 0;
+
+		// Visits the objects which intersect with the region. Nodes inside the region are taken without testing
+		// each object, and the disjoint nodes are skipped with their subtree.
+		virtual void QueryRegion(const BoundingFrustum& region, const ObjectFunc& func) const = 0;
+		virtual void QueryRegion(const BoundingOrientedBox& region, const ObjectFunc& func) const = 0;
+		virtual void QueryRegion(const BoundingSphere& region, const ObjectFunc& func) const = 0;
+
+		// Visits the objects around the point, stops if the function returns true.
+		virtual void Iterate(const Vector3& point, const std::function<bool(const WeakT&)>& func) const = 0;
+		virtual std::vector<WeakT> Nearest(const Vector3& point, float distance) const = 0;
+		// At most k nearest objects within the distance (0 for unbounded), ordered from the nearest. Result is
+		// allocated from the frame arena and is released by the next FrameArena::ResetAll(), which runs between
+		// the fixed updates and the update. Do not store the result, copy what is needed.
+		virtual frame_vector<WeakT> KNearest(const Vector3& point, size_t k, float distance = 0.f) const = 0;
+		virtual std::vector<WeakT> Hitscan(
+			const Vector3& point, const Vector3& direction, size_t count = 0, float distance = 0.f
+		) const = 0;
+		// Hitscan of the multiple rays, rays are traversed together in the packets. Hits are sorted by the
+		// distance per ray, and the count and the distance are applied to each ray.
+		RayHits HitscanBatch(std::span<const Ray> rays, size_t count = 0, float distance = 0.f) const;
+
+	protected:
+		constexpr static size_t packet_width = 4;
+
+		// Rays in the structure of arrays, one lane per ray.
+		struct RayPacket
+		{
+			__m128 origin_x;
+			__m128 origin_y;
+			__m128 origin_z;
+			__m128 inv_direction_x;
+			__m128 inv_direction_y;
+			__m128 inv_direction_z;
+			__m128 max_distance;
+			// Lanes that hold the ray.
+			int lane_mask;
+		};
+
+		using PacketHits = std::array<std::vector<std::pair<float, WeakT>>, packet_width>;
+
+		// Slab test of the lanes in the mask, returns the lanes that hit and their entry distance.
+		static int IntersectPacket(const BoundingBox& bounds, const RayPacket& packet, int mask, __m128& distance);
+		static void AppendHits(int hit, __m128 distance, const WeakT& object, PacketHits& hits);
+		// Squared distance from the point to the bounds, 0 if the point is inside.
+		static float __vectorcall DistanceSquared(const BoundingBox& bounds, const Vector3& point);
+		// Collects the hits of every lane, backend traverses its nodes with the packet.
+		virtual void hitscanPacket(const RayPacket& packet, PacketHits& hits) const = 0;
+
+		// Pops the moved object and consumes its notification, the move after this point is published again.
+		bool popMoved(StrongObjectBase& obj);
+		void clearMoved();
+
+		// Drops the deltas of the sensors, called at the beginning of the update.
+		void clearSensorEvents();
+		// Updates the sensors with the new bounds of the object.
+		void sense(GlobalEntityID id, const WeakT& obj, const BoundingBox& bounds);
+		// Removes the object from the sensors, and drops the sensors attached to it.
+		void unsense(GlobalEntityID id);
+		// Every member leaves, for clearing the index.
+		void leaveSensors();
+		// Re-evaluates the members of the sensors with the full query.
+		void reseedSensors();
+
+	private:
+		void reseed(ProximitySensor& sensor) const;
+
+		concurrent_queue<WeakT> m_moved_;
+
+		SensorID                                      m_next_sensor_id_ = 0;
+		std::unordered_map<SensorID, ProximitySensor> m_sensors_;
+	};
+}
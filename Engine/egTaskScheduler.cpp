@@ -1,20 +1,126 @@
 #include "pch.h"
 #include "egTaskScheduler.h"
 
+#include "egGlobal.h"
+#include "egManagerHelper.hpp"
+
 namespace Engine::Manager
 {
-	void TaskScheduler::Initialize() {}
+	void TaskScheduler::Initialize()
+	{
+		if (m_b_running_)
+		{
+			return;
+		}
+
+		// Main thread also participates in the work while waiting, leave one core for it.
+		const size_t worker_count = std::max<size_t>(std::thread::hardware_concurrency(), 2) - 1;
+
+		for (size_t i = 0; i < worker_count; ++i)
+		{
+			m_queues_.emplace_back(std::make_unique<WorkerQueue>());
+		}
+
+		m_b_running_ = true;
+
+		for (size_t i = 0; i < worker_count; ++i)
+		{
+			m_workers_.emplace_back(&TaskScheduler::workerLoop, this, i + 1);
+		}
+	}
 
 	void TaskScheduler::PreUpdate(const float& dt)
 	{
+		std::array<eTaskPriority, TASK_MAX> priorities;
+
+		{
+			std::lock_guard l(m_task_lock_);
+			const size_t other = m_arena_index_ ^ 1;
+			priorities         = m_priorities_;
+
+			// Tasks that are added while draining go to the other arena.
+			if (m_arena_live_[other] == 0)
+			{
+				m_arenas_[other].Reset();
+				m_arena_index_ = other;
+			}
+		}
+
+		using clock = std::chrono::steady_clock;
+
+		const auto start     = clock::now();
+		const auto budget    = std::chrono::microseconds(g_task_budget_us.load());
+		bool       exhausted = false;
+		size_t     drained   = 0;
+
 		for (int i = 0; i < TASK_MAX; ++i)
 		{
-			while (!m_tasks_[static_cast<eTaskType>(i)].empty())
+			// Later types may depend on the carried ones, keep the order of the task types.
+			if (exhausted)
 			{
-				auto task = m_tasks_[static_cast<eTaskType>(i)].front();
-				m_tasks_[static_cast<eTaskType>(i)].pop();
-				task.func(task.params, dt);
+				break;
 			}
+
+			auto&      list    = m_tasks_[i];
+			const bool bounded = budget.count() != 0 && priorities[i] == TASK_PRIORITY_BUDGETED;
+
+			while (true)
+			{
+				TaskRecord* record;
+
+				{
+					// Do not hold the lock while invoking, task can add another task.
+					std::lock_guard l(m_task_lock_);
+					record = list.head;
+
+					if (!record)
+					{
+						break;
+					}
+
+					if (bounded && clock::now() - start >= budget)
+					{
+						exhausted = true;
+						break;
+					}
+
+					list.head = record->next;
+
+					if (!list.head)
+					{
+						list.tail = nullptr;
+					}
+				}
+
+				const size_t arena = record->arena;
+
+				record->invoke(record, dt);
+				record->destroy(record);
+				++drained;
+
+				std::lock_guard l(m_task_lock_);
+				--m_arena_live_[arena];
+			}
+		}
+
+		std::lock_guard l(m_task_lock_);
+
+		m_statistics_.elapsed_us = std::chrono::duration<float, std::micro>(clock::now() - start).count();
+		m_statistics_.drained    = drained;
+		m_statistics_.deferred   = m_arena_live_[0] + m_arena_live_[1];
+
+		if (exhausted)
+		{
+			++m_statistics_.overruns;
+
+			GetDebugger().Log
+					(
+					 std::format
+					 (
+					  "Task budget exceeded, {} drained, {} carried to the next frame ({:.1f}us)",
+					  drained, m_statistics_.deferred, m_statistics_.elapsed_us
+					 )
+					);
 		}
 	}
 
@@ -29,4 +135,404 @@ namespace Engine::Manager
 	void TaskScheduler::PostUpdate(const float& dt) {}
 
 	void TaskScheduler::FixedUpdate(const float& dt) {}
+
+	TaskScheduler::JobHandle TaskScheduler::Spawn(const JobFunc& func, const std::vector<JobHandle>& dependencies)
+	{
+		const auto fence = std::make_shared<JobFence>();
+		fence->pending   = 1;
+
+		std::vector<Job> jobs;
+		jobs.push_back({func, fence});
+
+		return spawnImpl(std::move(jobs), fence, dependencies);
+	}
+
+	TaskScheduler::JobHandle TaskScheduler::SpawnBatch(
+		const size_t count, const JobBatchFunc& func, const std::vector<JobHandle>& dependencies
+	)
+	{
+		const auto fence = std::make_shared<JobFence>();
+		fence->pending   = count;
+
+		std::vector<Job> jobs;
+		jobs.reserve(count);
+
+		for (size_t i = 0; i < count; ++i)
+		{
+			jobs.push_back
+					(
+					 {
+						 [func, i]()
+						 {
+							 func(i);
+						 },
+						 fence
+					 }
+					);
+		}
+
+		return spawnImpl(std::move(jobs), fence, dependencies);
+	}
+
+	void TaskScheduler::Wait(const JobHandle& handle)
+	{
+		if (!handle)
+		{
+			return;
+		}
+
+		while (handle->pending.load(std::memory_order_acquire) != 0)
+		{
+			// Help the workers instead of blocking.
+			if (Job job; tryPop(job))
+			{
+				execute(job);
+				continue;
+			}
+
+			std::this_thread::yield();
+		}
+
+		std::exception_ptr exception;
+
+		{
+			std::lock_guard l(handle->lock);
+			exception = handle->exception;
+		}
+
+		if (exception)
+		{
+			std::rethrow_exception(exception);
+		}
+	}
+
+	void TaskScheduler::ParallelFor(const size_t count, const JobBatchFunc& func, const size_t grain)
+	{
+		if (count == 0)
+		{
+			return;
+		}
+
+		const size_t chunk       = std::max<size_t>(grain, 1);
+		const size_t chunk_count = (count + chunk - 1) / chunk;
+
+		// Not worth to distribute.
+		if (chunk_count == 1 || m_workers_.empty())
+		{
+			for (size_t i = 0; i < count; ++i)
+			{
+				func(i);
+			}
+
+			return;
+		}
+
+		// Exception of the chunk is carried to the caller by the fence.
+		const auto fence = SpawnBatch
+				(
+				 chunk_count, [&func, chunk, count](const size_t chunk_idx)
+				 {
+					 const size_t begin = chunk_idx * chunk;
+					 const size_t end   = std::min(begin + chunk, count);
+
+					 for (size_t i = begin; i < end; ++i)
+					 {
+						 func(i);
+					 }
+				 }
+				);
+
+		Wait(fence);
+	}
+
+	void TaskScheduler::SetTaskPriority(const eTaskType type, const eTaskPriority priority)
+	{
+		std::lock_guard l(m_task_lock_);
+		m_priorities_[type] = priority;
+	}
+
+	eTaskPriority TaskScheduler::GetTaskPriority(const eTaskType type) const
+	{
+		std::lock_guard l(m_task_lock_);
+		return m_priorities_[type];
+	}
+
+	TaskScheduler::DrainStatistics TaskScheduler::GetDrainStatistics() const
+	{
+		std::lock_guard l(m_task_lock_);
+		return m_statistics_;
+	}
+
+	void TaskScheduler::OnImGui()
+	{
+		if constexpr (g_debug)
+		{
+			if (ImGui::Begin("Task Scheduler"))
+			{
+				const auto statistics = GetDrainStatistics();
+
+				ImGui::Text("Drained: %zu", statistics.drained);
+				ImGui::Text("Carried: %zu", statistics.deferred);
+				ImGui::Text("Elapsed: %.1fus", statistics.elapsed_us);
+				ImGui::Text("Overruns: %llu", statistics.overruns);
+
+				int budget = static_cast<int>(g_task_budget_us.load());
+				if (ImGui::DragInt("Budget (us)", &budget, 10.f, 0, 100000))
+				{
+					g_task_budget_us = static_cast<UINT>(budget);
+				}
+
+				ImGui::End();
+			}
+		}
+	}
+
+	size_t TaskScheduler::GetWorkerCount() const
+	{
+		return m_workers_.size();
+	}
+
+	TaskScheduler::~TaskScheduler()
+	{
+		m_b_running_ = false;
+		m_sleep_cv_.notify_all();
+
+		for (auto& worker : m_workers_)
+		{
+			if (worker.joinable())
+			{
+				worker.join();
+			}
+		}
+
+		for (auto& list : m_tasks_)
+		{
+			while (list.head)
+			{
+				TaskRecord* record = list.head;
+				list.head          = record->next;
+				record->destroy(record);
+			}
+
+			list.tail = nullptr;
+		}
+	}
+
+	void* TaskScheduler::TaskArena::Allocate(const size_t size, const size_t alignment)
+	{
+		while (m_block_index_ < m_blocks_.size())
+		{
+			auto&        block   = m_blocks_[m_block_index_];
+			const size_t aligned = Align(m_offset_, alignment);
+
+			if (aligned + size <= block.size)
+			{
+				m_offset_ = aligned + size;
+				return block.data.get() + aligned;
+			}
+
+			++m_block_index_;
+			m_offset_ = 0;
+		}
+
+		// Out of the blocks, allocate a new one. Start of the block is aligned by the default new alignment.
+		const size_t new_size = std::max(block_size, size);
+		m_blocks_.push_back({std::make_unique<std::byte[]>(new_size), new_size});
+		m_block_index_ = m_blocks_.size() - 1;
+		m_offset_      = size;
+
+		return m_blocks_.back().data.get();
+	}
+
+	void TaskScheduler::TaskArena::Reset()
+	{
+		m_block_index_ = 0;
+		m_offset_      = 0;
+	}
+
+	TaskScheduler::JobHandle TaskScheduler::spawnImpl(
+		std::vector<Job>&& jobs, const JobHandle& fence, const std::vector<JobHandle>& dependencies
+	)
+	{
+		if (jobs.empty())
+		{
+			return fence;
+		}
+
+		const auto gate = std::make_shared<JobGate>();
+		gate->jobs      = std::move(jobs);
+		// Holds one more count to prevent the release while the dependencies are being registered.
+		gate->remaining = dependencies.size() + 1;
+
+		for (const auto& dependency : dependencies)
+		{
+			if (!dependency)
+			{
+				release(gate);
+				continue;
+			}
+
+			{
+				std::lock_guard l(dependency->lock);
+
+				if (dependency->pending.load(std::memory_order_acquire) != 0)
+				{
+					dependency->dependents.push_back(gate);
+					continue;
+				}
+			}
+
+			// Dependency is already finished.
+			release(gate);
+		}
+
+		release(gate);
+
+		return fence;
+	}
+
+	void TaskScheduler::workerLoop(const size_t index)
+	{
+		s_queue_index_ = index;
+
+		while (m_b_running_)
+		{
+			if (Job job; tryPop(job))
+			{
+				execute(job);
+				continue;
+			}
+
+			std::unique_lock l(m_sleep_lock_);
+			m_sleep_cv_.wait_for
+					(
+					 l, std::chrono::milliseconds(1), [this]()
+					 {
+						 return !m_b_running_ || m_queued_.load() != 0;
+					 }
+					);
+		}
+	}
+
+	void TaskScheduler::push(Job&& job)
+	{
+		const size_t index = s_queue_index_ < m_queues_.size() ? s_queue_index_ : 0;
+
+		{
+			auto& queue = *m_queues_[index];
+			std::lock_guard l(queue.lock);
+			queue.jobs.push_back(std::move(job));
+		}
+
+		++m_queued_;
+		m_sleep_cv_.notify_one();
+	}
+
+	bool TaskScheduler::tryPop(Job& job)
+	{
+		if (m_queued_.load(std::memory_order_acquire) == 0)
+		{
+			return false;
+		}
+
+		const size_t queue_count = m_queues_.size();
+		const size_t self        = s_queue_index_ < queue_count ? s_queue_index_ : 0;
+
+		// Own queue first, latest job is likely in the cache.
+		{
+			auto& queue = *m_queues_[self];
+			std::lock_guard l(queue.lock);
+
+			if (!queue.jobs.empty())
+			{
+				job = std::move(queue.jobs.back());
+				queue.jobs.pop_back();
+				--m_queued_;
+				return true;
+			}
+		}
+
+		// Steal the oldest job from the others.
+		for (size_t i = 1; i < queue_count; ++i)
+		{
+			auto& victim = *m_queues_[(self + i) % queue_count];
+			std::lock_guard l(victim.lock);
+
+			if (!victim.jobs.empty())
+			{
+				job = std::move(victim.jobs.front());
+				victim.jobs.pop_front();
+				--m_queued_;
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	void TaskScheduler::execute(Job& job)
+	{
+		// Fence must be signaled regardless of the job result, or the waiter spins forever.
+		try
+		{
+			job.func();
+		}
+		catch (...)
+		{
+			std::lock_guard l(job.fence->lock);
+
+			if (!job.fence->exception)
+			{
+				job.fence->exception = std::current_exception();
+			}
+		}
+
+		signal(job.fence);
+	}
+
+	void TaskScheduler::signal(const JobHandle& fence)
+	{
+		if (fence->pending.fetch_sub(1, std::memory_order_acq_rel) != 1)
+		{
+			return;
+		}
+
+		std::vector<std::shared_ptr<JobGate>> dependents;
+
+		{
+			std::lock_guard l(fence->lock);
+			dependents.swap(fence->dependents);
+		}
+
+		for (const auto& gate : dependents)
+		{
+			release(gate);
+		}
+	}
+
+	void TaskScheduler::release(const std::shared_ptr<JobGate>& gate)
+	{
+		if (gate->remaining.fetch_sub(1, std::memory_order_acq_rel) != 1)
+		{
+			return;
+		}
+
+		for (auto& job : gate->jobs)
+		{
+			push(std::move(job));
+		}
+
+		gate->jobs.clear();
+	}
+
+	ManagerAccess TaskScheduler::GetAccess(const eManagerPhase phase) const
+	{
+		switch (phase)
+		{
+		case MANAGER_PHASE_PRE_UPDATE:
+			return g_manager_access_exclusive;
+		default:
+			return g_manager_access_none;
+		}
+	}
 }
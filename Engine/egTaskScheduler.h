@@ -1,14 +1,24 @@
 #pragma once
 #include <any>
+#include <array>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
 #include <functional>
+#include <mutex>
 #include <numeric>
 #include <queue>
+#include <thread>
+#include <tuple>
 #include "egManager.hpp"
 
 namespace Engine::Manager
 {
 	class TaskScheduler : public Abstract::Singleton<TaskScheduler>
 	{
+	private:
+		struct JobGate;
+
 	public:
 		struct TaskValue
 		{
@@ -17,10 +27,52 @@ namespace Engine::Manager
 			std::vector<std::any> params;
 		};
 
+		// Completion counter of the spawned jobs. Jobs that are spawned with this fence as a
+		// dependency are released when the counter reaches zero.
+		struct JobFence
+		{
+			std::atomic<size_t>                   pending = 0;
+			std::mutex                            lock;
+			std::vector<std::shared_ptr<JobGate>> dependents;
+			// First exception thrown by the jobs of the fence, guarded by the lock.
+			std::exception_ptr exception;
+		};
+
+		struct DrainStatistics
+		{
+			float  elapsed_us = 0.f;
+			size_t drained    = 0;
+			size_t deferred   = 0;
+			// Count of the frames which could not drain every task within the budget.
+			UINT64 overruns = 0;
+		};
+
+		using JobHandle = std::shared_ptr<JobFence>;
+		using JobFunc = std::function<void()>;
+		using JobBatchFunc = std::function<void(size_t)>;
+
 		TaskScheduler(SINGLETON_LOCK_TOKEN)
-			: Singleton() {}
+			: Singleton(),
+			  m_arena_index_(0),
+			  m_arena_live_{0, 0},
+			  m_b_running_(false),
+			  m_queued_(0)
+		{
+			// Queue for the threads which are not the workers. (e.g., main thread)
+			m_queues_.emplace_back(std::make_unique<WorkerQueue>());
+
+			// Scene and layer level tasks are cheap and the others are waiting for them.
+			m_priorities_.fill(TASK_PRIORITY_BUDGETED);
+			m_priorities_[TASK_NONE]          = TASK_PRIORITY_IMMEDIATE;
+			m_priorities_[TASK_TOGGLE_RASTER] = TASK_PRIORITY_IMMEDIATE;
+			m_priorities_[TASK_CHANGE_LAYER]  = TASK_PRIORITY_IMMEDIATE;
+			m_priorities_[TASK_SYNC_SCENE]    = TASK_PRIORITY_IMMEDIATE;
+			m_priorities_[TASK_REM_SCENE]     = TASK_PRIORITY_IMMEDIATE;
+			m_priorities_[TASK_ACTIVE_SCENE]  = TASK_PRIORITY_IMMEDIATE;
+		}
 
 		void Initialize() override;
+		ManagerAccess GetAccess(eManagerPhase phase) const override;
 		void PreUpdate(const float& dt) override;
 		void Update(const float& dt) override;
 		void PreRender(const float& dt) override;
@@ -28,24 +80,188 @@ namespace Engine::Manager
 		void PostRender(const float& dt) override;
 		void PostUpdate(const float& dt) override;
 		void FixedUpdate(const float& dt) override;
+		void OnImGui() override;
+
+		// Deferred task, executed in the main thread at the start of the next frame.
+		// The callable and the arguments are stored in the per-frame arena, callable will be invoked
+		// with the stored arguments and the delta time. (e.g., func(args..., dt))
+		template <typename F, typename... Args>
+		void AddTask(const eTaskType type, F&& func, Args&&... args)
+		{
+			using record_type = TypedTaskRecord<std::decay_t<F>, std::decay_t<Args>...>;
+			static_assert(alignof(record_type) <= __STDCPP_DEFAULT_NEW_ALIGNMENT__, "Task record is over-aligned");
 
+			// Managers can be running concurrently, list and arena are guarded.
+			std::lock_guard l(m_task_lock_);
+
+			void* memory = m_arenas_[m_arena_index_].Allocate(sizeof(record_type), alignof(record_type));
+			auto* record = new(memory) record_type(std::forward<F>(func), std::forward<Args>(args)...);
+			record->arena = m_arena_index_;
+			++m_arena_live_[m_arena_index_];
+
+			auto& list = m_tasks_[type];
+
+			if (list.tail)
+			{
+				list.tail->next = record;
+			}
+			else
+			{
+				list.head = record;
+			}
+
+			list.tail = record;
+		}
+
+		// Type-erased deferred task. Prefer the typed version above, this allocates the parameters and
+		// the callback in the heap.
 		void AddTask(const eTaskType type, const std::vector<std::any>& params, const TaskSchedulerFunc& func)
 		{
-			m_tasks_[type].push
+			AddTask
 					(
+					 type, [](const TaskValue& task, const float dt)
 					 {
-						 type,
-						 func,
-						 params
-					 }
+						 task.func(task.params, dt);
+					 }, TaskValue{type, func, params}
 					);
 		}
 
+		// Tasks are drained in the order of the task type. Once the time budget runs out in a budgeted type with
+		// tasks left, that type and every type after it are carried to the next frame.
+		void          SetTaskPriority(eTaskType type, eTaskPriority priority);
+		eTaskPriority GetTaskPriority(eTaskType type) const;
+
+		DrainStatistics GetDrainStatistics() const;
+
+		// Spawn a job to the workers. Job will be started after all the dependencies are finished.
+		JobHandle Spawn(const JobFunc& func, const std::vector<JobHandle>& dependencies = {});
+		// Spawn the count of jobs which shares the same fence. Index of the job is given as a parameter.
+		JobHandle SpawnBatch(size_t count, const JobBatchFunc& func, const std::vector<JobHandle>& dependencies = {});
+		// Wait until the jobs of the fence are finished, the caller thread runs the queued jobs in the meantime.
+		// Rethrows the first exception thrown by the jobs.
+		void Wait(const JobHandle& handle);
+		// Split the range into the chunks by grain size, run it in the workers and wait for it.
+		void ParallelFor(size_t count, const JobBatchFunc& func, size_t grain = 1);
+
+		size_t GetWorkerCount() const;
+
 	private:
 		friend struct SingletonDeleter;
-		~TaskScheduler() override = default;
+		~TaskScheduler() override;
+
+		struct TaskRecord
+		{
+			void (*invoke)(TaskRecord*, float);
+			void (*destroy)(TaskRecord*);
+			TaskRecord* next  = nullptr;
+			size_t      arena = 0;
+		};
+
+		template <typename F, typename... Args>
+		struct TypedTaskRecord final : TaskRecord
+		{
+			template <typename FwdF, typename... FwdArgs>
+			explicit TypedTaskRecord(FwdF&& func, FwdArgs&&... args)
+				: TaskRecord{&Invoke, &Destroy},
+				  func(std::forward<FwdF>(func)),
+				  params(std::forward<FwdArgs>(args)...) {}
+
+			static void Invoke(TaskRecord* record, const float dt)
+			{
+				auto* self = static_cast<TypedTaskRecord*>(record);
+
+				std::apply
+						(
+						 [self, dt](Args&... unpacked)
+						 {
+							 self->func(unpacked..., dt);
+						 }, self->params
+						);
+			}
+
+			static void Destroy(TaskRecord* record)
+			{
+				static_cast<TypedTaskRecord*>(record)->~TypedTaskRecord();
+			}
+
+			F                   func;
+			std::tuple<Args...> params;
+		};
+
+		struct TaskList
+		{
+			TaskRecord* head = nullptr;
+			TaskRecord* tail = nullptr;
+		};
+
+		// Linear allocator for the task records, blocks are kept after reset for re-using.
+		class TaskArena
+		{
+		public:
+			void* Allocate(size_t size, size_t alignment);
+			void  Reset();
+
+		private:
+			constexpr static size_t block_size = 64 * 1024;
+
+			struct Block
+			{
+				std::unique_ptr<std::byte[]> data;
+				size_t                       size;
+			};
+
+			std::vector<Block> m_blocks_;
+			size_t             m_block_index_ = 0;
+			size_t             m_offset_      = 0;
+		};
+
+		struct Job
+		{
+			JobFunc   func;
+			JobHandle fence;
+		};
+
+		struct JobGate
+		{
+			std::atomic<size_t> remaining = 0;
+			std::vector<Job>    jobs;
+		};
+
+		struct WorkerQueue
+		{
+			std::mutex      lock;
+			std::deque<Job> jobs;
+		};
+
+		JobHandle spawnImpl(std::vector<Job>&& jobs, const JobHandle& fence, const std::vector<JobHandle>& dependencies);
+		void      workerLoop(size_t index);
+		void      push(Job&& job);
+		bool      tryPop(Job& job);
+		void      execute(Job& job);
+		void      signal(const JobHandle& fence);
+		void      release(const std::shared_ptr<JobGate>& gate);
+
+		std::array<TaskList, TASK_MAX> m_tasks_;
+		// Guarded by the task lock, the drain takes a copy at the start.
+		std::array<eTaskPriority, TASK_MAX> m_priorities_;
+		// Records are allocated in one arena while the other one is being drained. Arena is reset only if
+		// every record in it is consumed, carried over records keep the arena alive.
+		std::array<TaskArena, 2> m_arenas_;
+		size_t                   m_arena_index_;
+		std::array<size_t, 2>    m_arena_live_;
+		mutable std::mutex       m_task_lock_;
+		DrainStatistics          m_statistics_;
+
+		// index 0 is reserved for the non-worker threads.
+		std::vector<std::unique_ptr<WorkerQueue>> m_queues_;
+		std::vector<std::thread>                  m_workers_;
+
+		std::atomic<bool>       m_b_running_;
+		std::atomic<size_t>     m_queued_;
+		std::mutex              m_sleep_lock_;
+		std::condition_variable m_sleep_cv_;
 
-		std::map<eTaskType, std::queue<TaskValue>> m_tasks_;
+		inline static thread_local size_t s_queue_index_ = 0;
 	};
 } // namespace Engine::Manager
 
@@ -244,4 +244,17 @@ namespace Engine::Manager::Graphics
 				 )
 				);
 	}
+
+	ManagerAccess ToolkitAPI::GetAccess(const eManagerPhase phase) const
+	{
+		switch (phase)
+		{
+		case MANAGER_PHASE_UPDATE:
+			return {MANAGER_ACCESS_NONE, MANAGER_ACCESS_AUDIO};
+		case MANAGER_PHASE_SUBMIT:
+			return g_manager_access_exclusive;
+		default:
+			return g_manager_access_none;
+		}
+	}
 } // namespace Engine::Manager::Graphics
@@ -16,6 +16,7 @@ namespace Engine::Manager::Graphics
 		explicit ToolkitAPI(SINGLETON_LOCK_TOKEN) {}
 
 		void Initialize() override;
+		ManagerAccess GetAccess(eManagerPhase phase) const override;
 		void PreUpdate(const float& dt) override;
 		void Update(const float& dt) override;
 		void PreRender(const float& dt) override;
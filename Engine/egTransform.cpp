@@ -4,6 +4,7 @@
 #include "egImGuiHeler.hpp"
 #include "egManagerHelper.hpp"
 #include "egRigidbody.h"
+#include "egScene.hpp"
 
 SERIALIZE_IMPL
 (
@@ -36,7 +37,24 @@ namespace Engine::Components
 		  m_animation_position_(Vector3::Zero),
 		  m_animation_rotation_(Quaternion::Identity),
 		  m_animation_scale_(Vector3::One),
-		  m_animation_matrix_(Matrix::Identity) {}
+		  m_animation_matrix_(Matrix::Identity),
+		  m_b_moved_(false) {}
+
+	// Clone is not notified yet, the pending flag is not carried.
+	Transform::Transform(const Transform& other)
+		: Component(other),
+		  m_b_s_absolute_(other.m_b_s_absolute_),
+		  m_b_r_absolute_(other.m_b_r_absolute_),
+		  m_previous_position_(other.m_previous_position_),
+		  m_world_previous_position_(other.m_world_previous_position_),
+		  m_position_(other.m_position_),
+		  m_rotation_(other.m_rotation_),
+		  m_scale_(other.m_scale_),
+		  m_animation_position_(other.m_animation_position_),
+		  m_animation_rotation_(other.m_animation_rotation_),
+		  m_animation_scale_(other.m_animation_scale_),
+		  m_animation_matrix_(other.m_animation_matrix_),
+		  m_b_moved_(false) {}
 
 	void __vectorcall Transform::SetWorldPosition(const Vector3& position)
 	{
@@ -46,6 +64,8 @@ namespace Engine::Components
 		world                  = world.Invert();
 
 		m_position_ = Vector3::Transform(position, world);
+
+		NotifyMoved();
 	}
 
 	void __vectorcall Transform::SetWorldRotation(const Quaternion& rotation)
@@ -57,6 +77,8 @@ namespace Engine::Components
 		world.Inverse(world);
 
 		m_rotation_ = rotation * world;
+
+		NotifyMoved();
 	}
 
 	void Transform::SetWorldScale(const Vector3& scale)
@@ -66,21 +88,29 @@ namespace Engine::Components
 		world               = world / local;
 
 		m_scale_ = scale / world;
+
+		NotifyMoved();
 	}
 
 	void __vectorcall Transform::SetLocalPosition(const Vector3& position)
 	{
 		m_position_ = position;
+
+		NotifyMoved();
 	}
 
 	void __vectorcall Transform::SetLocalRotation(const Quaternion& rotation)
 	{
 		m_rotation_ = rotation;
+
+		NotifyMoved();
 	}
 
 	void __vectorcall Transform::SetLocalScale(const Vector3& scale)
 	{
 		m_scale_ = scale;
+
+		NotifyMoved();
 	}
 
 	void Transform::SetLocalMatrix(const Matrix& matrix)
@@ -90,16 +120,22 @@ namespace Engine::Components
 			throw std::runtime_error
 					("Matrix decomposition failed");
 		}
+
+		NotifyMoved();
 	}
 
 	void Transform::SetSizeAbsolute(bool absolute)
 	{
 		m_b_s_absolute_ = absolute;
+
+		NotifyMoved();
 	}
 
 	void Transform::SetRotateAbsolute(bool absolute)
 	{
 		m_b_r_absolute_ = absolute;
+
+		NotifyMoved();
 	}
 
 	void __vectorcall Transform::SetAnimationPosition(const Vector3& position)
@@ -108,6 +144,8 @@ namespace Engine::Components
 		m_animation_matrix_   = m_animation_matrix_ * Matrix::CreateTranslation(m_animation_position_).Invert();
 		m_animation_position_ = position;
 		m_animation_matrix_   = m_animation_matrix_ * Matrix::CreateTranslation(m_animation_position_);
+
+		NotifyMoved();
 	}
 
 	void __vectorcall Transform::SetAnimationRotation(const Quaternion& rotation)
@@ -117,6 +155,8 @@ namespace Engine::Components
 		m_animation_matrix_   = Matrix::CreateScale(m_animation_scale_) *
 		                        Matrix::CreateFromQuaternion(m_animation_rotation_) *
 		                        Matrix::CreateTranslation(m_animation_position_);
+
+		NotifyMoved();
 	}
 
 	void __vectorcall Transform::SetAnimationScale(const Vector3& scale)
@@ -125,11 +165,58 @@ namespace Engine::Components
 		m_animation_matrix_ = Matrix::CreateScale(m_animation_scale_).Invert() * m_animation_matrix_;
 		m_animation_scale_  = scale;
 		m_animation_matrix_ = Matrix::CreateScale(m_animation_scale_) * m_animation_matrix_;
+
+		NotifyMoved();
 	}
 
 	void Transform::SetAnimationMatrix(const Matrix& matrix)
 	{
 		m_animation_matrix_ = matrix;
+
+		NotifyMoved();
+	}
+
+	void Transform::NotifyMoved()
+	{
+		// Already published, will be resolved in the next tree update.
+		if (m_b_moved_.load(std::memory_order_acquire))
+		{
+			return;
+		}
+
+		const auto owner = GetOwner().lock();
+
+		if (!owner)
+		{
+			return;
+		}
+
+		const auto scene = owner->GetScene().lock();
+
+		if (!scene)
+		{
+			return;
+		}
+
+		// Only one of the concurrent setters publishes.
+		if (m_b_moved_.exchange(true, std::memory_order_acq_rel))
+		{
+			return;
+		}
+
+		scene->NotifyMoved(owner);
+
+		// World bounds of the children are derived from this transform.
+		for (const auto& child : owner->GetChildren())
+		{
+			if (const auto locked = child.lock())
+			{
+				if (const auto transform = locked->GetComponent<Transform>().lock())
+				{
+					transform->NotifyMoved();
+				}
+			}
+		}
 	}
 
 	Vector3 Transform::GetWorldPosition()
@@ -249,6 +336,8 @@ namespace Engine::Components
 	void Transform::Translate(Vector3 translation)
 	{
 		m_position_ += translation;
+
+		NotifyMoved();
 	}
 
 	void Transform::Initialize()
@@ -285,12 +374,8 @@ namespace Engine::Components
 		{
 			GetTaskScheduler().AddTask(
 				TASK_TF_UPDATE,
-				{ m_previous_position_, GetSharedPtr<Transform>() },
-				[](const std::vector<std::any>& params, const float)
+				[](const Vector3& position, const boost::shared_ptr<Transform>& transform, const float)
 				{
-					const Vector3 position = std::any_cast<Vector3>(params[0]);
-					const boost::shared_ptr<Transform> transform = std::any_cast<boost::shared_ptr<Transform>>(params[1]);
-
 					transform->m_previous_position_ = position;
 
 					if (const Strong<Abstract::ObjectBase>& owner = transform->GetOwner().lock())
@@ -300,7 +385,8 @@ namespace Engine::Components
 							rb->Synchronize();
 						}
 					}
-				}
+				},
+				m_previous_position_, GetSharedPtr<Transform>()
 			);
 		}
 
@@ -308,13 +394,10 @@ namespace Engine::Components
 		{
 			GetTaskScheduler().AddTask(
 				TASK_TF_UPDATE,
-				{ m_position_, GetSharedPtr<Transform>() },
-				[](const std::vector<std::any>& params, const float)
+				[](const Vector3& position, const boost::shared_ptr<Transform>& transform, const float)
 				{
-					const Vector3 position = std::any_cast<Vector3>(params[0]);
-					const boost::shared_ptr<Transform> transform = std::any_cast<boost::shared_ptr<Transform>>(params[1]);
-
 					transform->m_position_ = position;
+					transform->NotifyMoved();
 
 					if (const Strong<Abstract::ObjectBase>& owner = transform->GetOwner().lock())
 					{
@@ -323,13 +406,15 @@ namespace Engine::Components
 							rb->Synchronize();
 						}
 					}
-				}
+				},
+				m_position_, GetSharedPtr<Transform>()
 			);
 		}
 
 		if (ImGuiVector3Editable("Scale", GetID(), "scale", m_scale_, 0.1f, 0.1f))
 		{
 			ZeroToEpsilon(m_scale_);
+			NotifyMoved();
 		}
 
 		Vector3 euler = m_rotation_.ToEuler();
@@ -347,6 +432,7 @@ namespace Engine::Components
 					 DirectX::XMConvertToRadians(euler.y), DirectX::XMConvertToRadians
 					 (euler.x), DirectX::XMConvertToRadians(euler.z)
 					);
+			NotifyMoved();
 		}
 
 		CheckboxAligned("Size Absolute", m_b_s_absolute_);
@@ -416,7 +502,8 @@ namespace Engine::Components
 		  m_animation_position_(Vector3::Zero),
 		  m_animation_rotation_(Quaternion::Identity),
 		  m_animation_scale_(Vector3::One),
-		  m_animation_matrix_(Matrix::Identity) {}
+		  m_animation_matrix_(Matrix::Identity),
+		  m_b_moved_(false) {}
 
 	WeakTransform Transform::FindNextTransform(const Transform& transform_)
 	{
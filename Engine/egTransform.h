@@ -12,6 +12,7 @@ namespace Engine::Components
 		COMPONENT_T(COM_T_TRANSFORM)
 
 		Transform(const WeakObjectBase& owner);
+		Transform(const Transform& other);
 		~Transform() override = default;
 
 		void __vectorcall SetWorldPosition(const Vector3& position);
@@ -49,6 +50,10 @@ namespace Engine::Components
 
 		void Translate(Vector3 translation);
 
+		// Publishes the owner and its children to the scene, the spatial structures relocate them in the
+		// next update. Setters call this, the caller does not need to unless the bounds are changed otherwise.
+		void NotifyMoved();
+
 		void Initialize() override;
 		void PreUpdate(const float& dt) override;
 		void Update(const float& dt) override;
@@ -69,6 +74,7 @@ namespace Engine::Components
 		friend class Manager::Physics::LerpManager;
 		friend class Manager::Graphics::ShadowManager;
 		friend class Manager::Graphics::Renderer;
+		friend class Engine::SpatialIndex;
 
 		static WeakTransform FindNextTransform(const Transform& transform_);
 
@@ -87,6 +93,9 @@ namespace Engine::Components
 		Quaternion m_animation_rotation_;
 		Vector3    m_animation_scale_;
 		Matrix     m_animation_matrix_;
+
+		// Set while the move notification is pending in the scene. Setters can be called from the workers.
+		std::atomic<bool> m_b_moved_;
 	};
 } // namespace Engine::Component
 
@@ -88,6 +88,7 @@ namespace Engine
 	class Script;
 	class Scene;
 	class Layer;
+	class SpatialIndex;
 	class Serializer;
 	struct ComponentPriorityComparer;
 
@@ -335,6 +336,7 @@ namespace Engine
 	using eShaderDepths = UINT;
 	using eShaderSamplers = UINT;
 	using eTexBindSlots = UINT;
+	using eManagerAccesses = UINT;
 
 	// Manager Forward Declaration
 	extern Manager::ResourceManager&               GetResourceManager();